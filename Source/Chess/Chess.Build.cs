@@ -10,7 +10,7 @@ public class Chess : ModuleRules
 	
 		PublicDependencyModuleNames.AddRange(new string[] { 
 		    "Core", "CoreUObject", 
-		    "Engine", "InputCore",
+		    "Engine", "InputCore", "ChessCore",
 		    "ApexDestruction", "OnlineSubsystem", 
 		    "OnlineSubsystemUtils" });
         
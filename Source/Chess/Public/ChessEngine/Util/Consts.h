@@ -1,8 +0,0 @@
-// Copyright 2018 Emre Simsirli
-
-#pragma once
-
-constexpr auto n_board_squares_x = 120;
-constexpr auto n_board_squares = 64;
-constexpr auto n_pieces = 13;
-constexpr auto max_depth = 64;
@@ -0,0 +1,16 @@
+// Copyright 2018 Emre Simsirli
+
+using UnrealBuildTool;
+
+// the chess engine itself, free of Engine dependencies so that
+// it can be linked into both the game and the ChessUci program
+public class ChessCore : ModuleRules
+{
+	public ChessCore(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(new string[] {
+		    "Core", "CoreUObject" });
+	}
+}
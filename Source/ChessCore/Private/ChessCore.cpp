@@ -0,0 +1,7 @@
+// Copyright 2018 Emre Simsirli
+
+#include "ChessCore.h"
+#include "Modules/ModuleManager.h"
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, ChessCore);
+DEFINE_LOG_CATEGORY(LogChessEngine);
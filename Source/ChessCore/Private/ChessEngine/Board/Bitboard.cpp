@@ -0,0 +1,343 @@
+// Copyright 2018 Emre Simsirli
+
+#include "Bitboard.h"
+#include "Consts.h"
+#include "Square.h"
+#include "Side.h"
+#include "Util/Log.h"
+
+#ifdef DEBUG
+#include "CString.h"
+#endif
+
+uint64 set_mask[n_board_squares];
+uint64 clr_mask[n_board_squares];
+uint32 btable[n_board_squares] = {
+    63, 30, 3, 32, 25, 41, 22, 33, 15, 50, 42, 13,
+    11, 53, 19, 34, 61, 29, 2, 51, 21, 43, 45, 10,
+    18, 47, 1, 54, 9, 57, 0, 35, 62, 31, 40, 4, 49,
+    5, 52, 26, 60, 6, 23, 44, 46, 27, 56, 16, 7, 39,
+    48, 24, 59, 14, 12, 55, 38, 28, 58, 20, 37, 17, 36, 8
+};
+
+namespace
+{
+    struct FMagic
+    {
+        uint64 Mask;
+        uint64 Magic;
+        uint64* Attacks;
+        uint32 Shift;
+
+        uint32 Index(const uint64 occupancy) const
+        {
+            return static_cast<uint32>((occupancy & Mask) * Magic >> Shift);
+        }
+    };
+
+    // file, rank deltas
+    const int32 bishop_directions[4][2] = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+    const int32 rook_directions[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+    const int32 knight_directions[8][2] = {{1, 2}, {2, 1}, {2, -1}, {1, -2}, {-1, -2}, {-2, -1}, {-2, 1}, {-1, 2}};
+    const int32 king_directions[8][2] = {{1, 1}, {1, 0}, {1, -1}, {0, -1}, {-1, -1}, {-1, 0}, {-1, 1}, {0, 1}};
+
+    uint64 pawn_attacks[2][n_board_squares];
+    uint64 knight_attacks[n_board_squares];
+    uint64 king_attacks[n_board_squares];
+
+    FMagic bishop_magics[n_board_squares];
+    FMagic rook_magics[n_board_squares];
+    uint64 bishop_table[0x1480];
+    uint64 rook_table[0x19000];
+
+    uint64 between_table[n_board_squares][n_board_squares];
+    uint64 line_table[n_board_squares][n_board_squares];
+
+    int32 PopCount(uint64 b)
+    {
+        auto count = 0;
+        while(b) {
+            b &= b - 1;
+            count++;
+        }
+        return count;
+    }
+
+    bool IsOnBoard(const int32 file, const int32 rank)
+    {
+        return file >= 0 && file < 8 && rank >= 0 && rank < 8;
+    }
+
+    uint64 StepAttacks(const uint32 sq, const int32 (*directions)[2], const int32 n_directions)
+    {
+        const int32 file = sq % 8;
+        const int32 rank = sq / 8;
+
+        uint64 attacks = 0;
+        for(auto i = 0; i < n_directions; ++i) {
+            const auto f = file + directions[i][0];
+            const auto r = rank + directions[i][1];
+            if(IsOnBoard(f, r))
+                attacks |= 1ULL << (r * 8 + f);
+        }
+        return attacks;
+    }
+
+    uint64 SlidingAttacks(const uint32 sq, const uint64 occupancy, const int32 (&directions)[4][2])
+    {
+        uint64 attacks = 0;
+        for(auto& dir : directions) {
+            auto f = static_cast<int32>(sq % 8) + dir[0];
+            auto r = static_cast<int32>(sq / 8) + dir[1];
+            while(IsOnBoard(f, r)) {
+                const auto b = 1ULL << (r * 8 + f);
+                attacks |= b;
+                if(occupancy & b)
+                    break;
+                f += dir[0];
+                r += dir[1];
+            }
+        }
+        return attacks;
+    }
+
+    // fixed seed so that the same magics are found on every run
+    uint64 SparseRand(uint64& seed)
+    {
+        auto next = [&seed]() -> uint64
+        {
+            seed ^= seed >> 12;
+            seed ^= seed << 25;
+            seed ^= seed >> 27;
+            return seed * 2685821657736338717ULL;
+        };
+        return next() & next() & next();
+    }
+
+    uint64 Ray(const uint32 sq, const int32 (&direction)[2])
+    {
+        uint64 ray = 0;
+        auto f = static_cast<int32>(sq % 8) + direction[0];
+        auto r = static_cast<int32>(sq / 8) + direction[1];
+        while(IsOnBoard(f, r)) {
+            ray |= 1ULL << (r * 8 + f);
+            f += direction[0];
+            r += direction[1];
+        }
+        return ray;
+    }
+
+    void InitLines()
+    {
+        for(uint32 sq = 0; sq < n_board_squares; ++sq) {
+            for(auto& dir : king_directions) {
+                const int32 opposite[2] = {-dir[0], -dir[1]};
+                const auto line = Ray(sq, dir) | Ray(sq, opposite) | 1ULL << sq;
+
+                uint64 between = 0;
+                auto f = static_cast<int32>(sq % 8) + dir[0];
+                auto r = static_cast<int32>(sq / 8) + dir[1];
+                while(IsOnBoard(f, r)) {
+                    const auto other = r * 8 + f;
+                    between_table[sq][other] = between;
+                    line_table[sq][other] = line;
+                    between |= 1ULL << other;
+                    f += dir[0];
+                    r += dir[1];
+                }
+            }
+        }
+    }
+
+    void InitMagics(FMagic* magics, uint64* table, const int32 (&directions)[4][2])
+    {
+        static uint64 occupancies[4096];
+        static uint64 references[4096];
+        // the attempt counter starts over for each piece, so the epochs must too
+        int32 epoch[4096] = {};
+
+        const uint64 rank_edges = 0xFF000000000000FFULL;
+        const uint64 file_edges = 0x8181818181818181ULL;
+
+        uint64 seed = 0x9E3779B97F4A7C15ULL;
+        auto* attacks = table;
+        auto attempt = 0;
+
+        for(uint32 sq = 0; sq < n_board_squares; ++sq) {
+            auto& m = magics[sq];
+
+            const auto edges = (rank_edges & ~(0xFFULL << (sq / 8 * 8)))
+                | (file_edges & ~(0x0101010101010101ULL << (sq % 8)));
+            m.Mask = SlidingAttacks(sq, 0, directions) & ~edges;
+            m.Shift = 64 - PopCount(m.Mask);
+            m.Attacks = attacks;
+
+            // carry-rippler trick enumerates every subset of the mask
+            auto size = 0;
+            uint64 b = 0;
+            do {
+                occupancies[size] = b;
+                references[size] = SlidingAttacks(sq, b, directions);
+                size++;
+                b = (b - m.Mask) & m.Mask;
+            } while(b);
+
+            for(auto found = false; !found;) {
+                do {
+                    m.Magic = SparseRand(seed);
+                } while(PopCount(m.Mask * m.Magic >> 56) < 6);
+
+                ++attempt;
+                found = true;
+                for(auto i = 0; i < size; ++i) {
+                    const auto index = m.Index(occupancies[i]);
+                    if(epoch[index] < attempt) {
+                        epoch[index] = attempt;
+                        attacks[index] = references[i];
+                    } else if(attacks[index] != references[i]) {
+                        found = false;
+                        break;
+                    }
+                }
+            }
+
+            attacks += size;
+        }
+    }
+}
+
+FBitboard::FBitboard()
+{
+    board_ = 0;
+}
+
+FBitboard::FBitboard(const uint64 board)
+{
+    board_ = board;
+}
+
+void FBitboard::SetSquare(const uint32 sq)
+{
+    board_ |= set_mask[sq];
+}
+
+void FBitboard::ClearSquare(const uint32 sq)
+{
+    board_ &= clr_mask[sq];
+}
+
+uint32 FBitboard::Pop()
+{
+    const auto b = board_ ^ (board_ - 1);
+    const uint32 fold = (b & 0xFFFFFFFF) ^ (b >> 32);
+    board_ &= board_ - 1;
+    return btable[fold * 0x783a9b23 >> 26];
+}
+
+int32 FBitboard::Count() const
+{
+    auto board = board_;
+    auto count = 0;
+    while(board) {
+        board &= board - 1;
+        count++;
+    }
+    return count;
+}
+
+void FBitboard::Empty()
+{
+    board_ = 0;
+}
+
+bool FBitboard::IsEmpty() const
+{
+    return board_ == 0;
+}
+
+uint64 FBitboard::Get() const
+{
+    return board_;
+}
+
+uint64 FBitboard::PawnAttacks(const uint32 side, const uint32 sq)
+{
+    return pawn_attacks[side][sq];
+}
+
+uint64 FBitboard::KnightAttacks(const uint32 sq)
+{
+    return knight_attacks[sq];
+}
+
+uint64 FBitboard::KingAttacks(const uint32 sq)
+{
+    return king_attacks[sq];
+}
+
+uint64 FBitboard::BishopAttacks(const uint32 sq, const uint64 occupancy)
+{
+    const auto& m = bishop_magics[sq];
+    return m.Attacks[m.Index(occupancy)];
+}
+
+uint64 FBitboard::RookAttacks(const uint32 sq, const uint64 occupancy)
+{
+    const auto& m = rook_magics[sq];
+    return m.Attacks[m.Index(occupancy)];
+}
+
+uint64 FBitboard::Between(const uint32 sq1, const uint32 sq2)
+{
+    return between_table[sq1][sq2];
+}
+
+uint64 FBitboard::Line(const uint32 sq1, const uint32 sq2)
+{
+    return line_table[sq1][sq2];
+}
+
+#ifdef DEBUG
+FString FBitboard::ToString() const
+{
+    FString str;
+
+    const uint64 s = 1L;
+    for(auto rank : ERank::AllReversed) {
+        for(auto file : EFile::All) {
+            const auto sq64 = ESquare::Sq64(file, rank);
+
+            if(s << sq64 & board_)
+                str += "X";
+            else
+                str += "-";
+        }
+        str += "\n";
+    }
+
+    return str;
+}
+#endif
+
+void FBitboard::Initialize()
+{
+    for(uint32 i = 0; i < n_board_squares; ++i) {
+        set_mask[i] = 1ULL << i;
+        clr_mask[i] = ~set_mask[i];
+    }
+
+    const int32 white_pawn_directions[2][2] = {{-1, 1}, {1, 1}};
+    const int32 black_pawn_directions[2][2] = {{-1, -1}, {1, -1}};
+    for(uint32 sq = 0; sq < n_board_squares; ++sq) {
+        pawn_attacks[ESide::white][sq] = StepAttacks(sq, white_pawn_directions, 2);
+        pawn_attacks[ESide::black][sq] = StepAttacks(sq, black_pawn_directions, 2);
+        knight_attacks[sq] = StepAttacks(sq, knight_directions, 8);
+        king_attacks[sq] = StepAttacks(sq, king_directions, 8);
+    }
+
+    InitMagics(bishop_magics, bishop_table, bishop_directions);
+    InitMagics(rook_magics, rook_table, rook_directions);
+    InitLines();
+
+    LOGI("initialized");
+}
@@ -3,19 +3,20 @@
 #include "Board.h"
 #include "Search.h"
 #include "PosKey.h"
+#include "PolyglotKey.h"
 #include "PieceInfo.h"
+#include "PieceSquare.h"
 #include "Square.h"
 #include "Undo.h"
 #include "Verify.h"
 #include "Side.h"
 #include "Util/Log.h"
 
-#define MAX_POSITION_MOVES 256
-
 #define HASH_PIECE(p, sq)   (pos_key_ ^= PosKey::GetPieceKey(p, sq))
 #define HASH_CASTL()        (pos_key_ ^= PosKey::GetCastleKey(cast_perm_))
 #define HASH_SIDE()         (pos_key_ ^= PosKey::GetSideKey())
-#define HASH_EN_P()         (pos_key_ ^= PosKey::GetPieceKey(EPieceType::empty, en_passant_sq_))
+#define HASH_PAWN(p, sq)    (pawn_key_ ^= PosKey::GetPieceKey(p, sq))
+#define HASH_EN_P()         (pos_key_ ^= PosKey::GetEnPassantKey(ESquare::File(en_passant_sq_)))
 
 namespace
 {
@@ -38,6 +39,7 @@ namespace
 }
 
 UBoard::UBoard()
+    : copy_make_(false), n_saved_positions_(0)
 {
     Set(start_fen);
 }
@@ -53,26 +55,36 @@ void UBoard::Reset()
     for(auto& pawns : pawns_)
         pawns.Empty();
 
+    for(auto& pieces : pieces_)
+        pieces.Empty();
+
+    for(auto& occupancy : occupancy_)
+        occupancy.Empty();
+
     for(uint32 i = 0; i < 2; ++i) {
         n_big_pieces_[i] = 0;
         n_major_pieces_[i] = 0;
         n_minor_pieces_[i] = 0;
         material_score_[i] = 0;
     }
+    middlegame_score_ = 0;
+    endgame_score_ = 0;
 
     for(auto& locs : piece_locations_)
-        locs.SetNum(0);
+        locs.Reset();
 
     for(auto& k_sq : king_sq_)
         k_sq = ESquare::no_sq;
 
-    history_.Reset();
+    history_count_ = 0;
     side_ = ESide::both;
     en_passant_sq_ = ESquare::no_sq;
     fifty_move_counter_ = 0;
+    plies_since_null_ = 0;
     ply_ = 0;
     cast_perm_ = 0;
     pos_key_ = 0;
+    pawn_key_ = 0;
 }
 
 bool UBoard::Set(const FString& fen)
@@ -190,6 +202,7 @@ bool UBoard::Set(const FString& fen)
     }
 
     pos_key_ = GeneratePositionKey();
+    pawn_key_ = GeneratePawnKey();
     UpdateMaterial();
 
     LOGI("new fen: %s\n%s", *fen, *ToString());
@@ -197,12 +210,45 @@ bool UBoard::Set(const FString& fen)
     return true;
 }
 
+void UBoard::CopyFrom(const UBoard* other)
+{
+    static_cast<FPosition&>(*this) = *other;
+    ply_ = other->ply_;
+    history_count_ = other->history_count_;
+    FMemory::Memcpy(history_, other->history_, history_count_ * sizeof(FUndo));
+    // the saved positions belong to moves made on the other board
+    n_saved_positions_ = 0;
+
+    MAKE_SURE(IsOk());
+}
+
+void UBoard::SaveTo(FPosition& position, TArray<FUndo>& history) const
+{
+    position = *this;
+    history.Reset();
+    history.Append(history_, history_count_);
+}
+
+void UBoard::RestoreFrom(const FPosition& position, const TArray<FUndo>& history)
+{
+    MAKE_SURE(history.Num() <= max_game_plies + max_depth);
+
+    static_cast<FPosition&>(*this) = position;
+    // searches count their plies from zero anyway
+    ply_ = 0;
+    history_count_ = history.Num();
+    FMemory::Memcpy(history_, history.GetData(), history_count_ * sizeof(FUndo));
+    n_saved_positions_ = 0;
+
+    MAKE_SURE(IsOk());
+}
+
 uint8 UBoard::GetSide() const
 {
     return side_;
 }
 
-TArray<uint32>* UBoard::GetPieceLocations()
+const FPieceList* UBoard::GetPieceLocations() const
 {
     return piece_locations_;
 }
@@ -224,7 +270,7 @@ uint64 UBoard::GeneratePositionKey() const
 
     if(en_passant_sq_ != ESquare::no_sq) {
         MAKE_SURE(en_passant_sq_ >= 0 && en_passant_sq_ < n_board_squares_x);
-        key ^= PosKey::GetPieceKey(EPieceType::empty, en_passant_sq_);
+        key ^= PosKey::GetEnPassantKey(ESquare::File(en_passant_sq_));
     }
 
     MAKE_SURE(cast_perm_ >= 0 && cast_perm_ < 16);
@@ -232,12 +278,48 @@ uint64 UBoard::GeneratePositionKey() const
     return key;
 }
 
+uint64 UBoard::GeneratePawnKey() const
+{
+    uint64 key = 0;
+    for(uint32 sq = 0; sq < n_board_squares_x; ++sq) {
+        const auto p = b_[sq];
+        if(p == EPieceType::wp || p == EPieceType::bp)
+            key ^= PosKey::GetPieceKey(p, sq);
+    }
+    return key;
+}
+
+uint64 UBoard::GeneratePolyglotKey() const
+{
+    uint64 key = 0;
+    for(uint32 sq64 = 0; sq64 < n_board_squares; ++sq64) {
+        const auto sq = ESquare::Sq120(sq64);
+        const auto p = b_[sq];
+        if(p != EPieceType::empty)
+            key ^= PolyglotKey::GetPieceKey(p, ESquare::File(sq), ESquare::Rank(sq));
+    }
+
+    key ^= PolyglotKey::GetCastleKey(cast_perm_);
+
+    // polyglot only hashes the en passant file when a pawn can actually take there
+    if(en_passant_sq_ != ESquare::no_sq) {
+        const auto pawn = side_ == ESide::white ? EPieceType::wp : EPieceType::bp;
+        const auto behind = side_ == ESide::white ? -10 : 10;
+        if(b_[en_passant_sq_ + behind - 1] == pawn || b_[en_passant_sq_ + behind + 1] == pawn)
+            key ^= PolyglotKey::GetEnPassantKey(ESquare::File(en_passant_sq_));
+    }
+
+    if(side_ == ESide::white)
+        key ^= PolyglotKey::GetSideKey();
+    return key;
+}
+
 void UBoard::UpdateMaterial()
 {
     for(uint32 sq = 0; sq < n_board_squares_x; ++sq) {
         const auto piece = b_[sq];
         if(piece != ESquare::offboard && piece != EPieceType::empty) {
-            const auto piece_info = piece_infos[piece];
+            const auto& piece_info = piece_infos[piece];
             const auto side = piece_info.Side;
 
             if(piece_info.bIsBig) {
@@ -249,7 +331,14 @@ void UBoard::UpdateMaterial()
             }
 
             material_score_[side] += piece_info.Value;
-            piece_locations_[piece].Add(sq);
+            piece_slots_[sq] = piece_locations_[piece].Add(sq);
+
+            const auto sq64 = ESquare::Sq64(sq);
+            middlegame_score_ += PieceSquare::GetMiddlegameScore(piece, sq64);
+            endgame_score_ += PieceSquare::GetEndgameScore(piece, sq64);
+            pieces_[piece].SetSquare(sq64);
+            occupancy_[side].SetSquare(sq64);
+            occupancy_[ESide::both].SetSquare(sq64);
 
             switch(piece) {
                 case EPieceType::wk:
@@ -285,6 +374,13 @@ bool UBoard::MakeMove(const FMove& m)
     MAKE_SURE(Verification::IsSideValid(side));
     MAKE_SURE(Verification::IsPieceValid(b_[from]));
 
+    if(IsUndoStackFull())
+        return false;
+
+    if(copy_make_) {
+        saved_positions_[n_saved_positions_++] = *this;
+    }
+
     auto u = FUndo(m);
     u.pos_key = pos_key_;
 
@@ -318,6 +414,7 @@ bool UBoard::MakeMove(const FMove& m)
     HASH_CASTL();
 
     u.fifty_move_counter = fifty_move_counter_;
+    u.plies_since_null = plies_since_null_;
     u.en_passant_sq = en_passant_sq_;
     u.cast_perm = cast_perm_;
 
@@ -328,6 +425,7 @@ bool UBoard::MakeMove(const FMove& m)
     HASH_CASTL();
 
     fifty_move_counter_++;
+    plies_since_null_++;
 
     const auto captured = m.CapturedPiece();
     if(captured != EPieceType::empty) {
@@ -337,7 +435,7 @@ bool UBoard::MakeMove(const FMove& m)
     }
 
     ply_++;
-    history_.Add(u);
+    history_[history_count_++] = u;
 
     if(piece_infos[b_[from]].bIsPawn) {
         fifty_move_counter_ = 0;
@@ -383,9 +481,17 @@ void UBoard::TakeMove()
 {
     MAKE_SURE(IsOk());
 
-    auto h = history_.Pop();
+    const auto& h = history_[--history_count_];
     ply_--;
 
+    if(copy_make_) {
+        MAKE_SURE(n_saved_positions_ > 0);
+        static_cast<FPosition&>(*this) = saved_positions_[--n_saved_positions_];
+        MAKE_SURE(pos_key_ == h.pos_key);
+        MAKE_SURE(IsOk());
+        return;
+    }
+
     const auto from = h.move.From();
     const auto to = h.move.To();
     MAKE_SURE(Verification::IsSquareOnBoard(from));
@@ -397,6 +503,7 @@ void UBoard::TakeMove()
 
     cast_perm_ = h.cast_perm;
     fifty_move_counter_ = h.fifty_move_counter;
+    plies_since_null_ = h.plies_since_null;
     en_passant_sq_ = h.en_passant_sq;
 
     if(en_passant_sq_ != ESquare::no_sq)
@@ -449,6 +556,68 @@ void UBoard::TakeMove()
     MAKE_SURE(IsOk());
 }
 
+bool UBoard::MakeNullMove()
+{
+    MAKE_SURE(IsOk());
+    MAKE_SURE(!IsInCheck());
+
+    if(IsUndoStackFull())
+        return false;
+
+    auto u = FUndo(FMove::no_move);
+    u.pos_key = pos_key_;
+    u.cast_perm = cast_perm_;
+    u.en_passant_sq = en_passant_sq_;
+    u.fifty_move_counter = fifty_move_counter_;
+    u.plies_since_null = plies_since_null_;
+
+    ply_++;
+    history_[history_count_++] = u;
+    plies_since_null_ = 0;
+
+    if(en_passant_sq_ != ESquare::no_sq)
+        HASH_EN_P();
+    en_passant_sq_ = ESquare::no_sq;
+
+    side_ ^= 1;
+    HASH_SIDE();
+
+    MAKE_SURE(IsOk());
+    return true;
+}
+
+void UBoard::TakeNullMove()
+{
+    MAKE_SURE(IsOk());
+
+    const auto& h = history_[--history_count_];
+    ply_--;
+
+    plies_since_null_ = h.plies_since_null;
+    en_passant_sq_ = h.en_passant_sq;
+    if(en_passant_sq_ != ESquare::no_sq)
+        HASH_EN_P();
+
+    side_ ^= 1;
+    HASH_SIDE();
+
+    MAKE_SURE(pos_key_ == h.pos_key);
+    MAKE_SURE(IsOk());
+}
+
+bool UBoard::IsUndoStackFull() const
+{
+    if(history_count_ >= max_game_plies + max_depth)
+        return true;
+    return copy_make_ && n_saved_positions_ >= max_depth;
+}
+
+void UBoard::SetCopyMake(const bool copy_make)
+{
+    MAKE_SURE(n_saved_positions_ == 0);
+    copy_make_ = copy_make;
+}
+
 bool UBoard::IsInCheck()
 {
     return IsAttacked(king_sq_[side_], side_ ^ 1);
@@ -460,65 +629,110 @@ bool UBoard::IsAttacked(const uint32 sq, const uint8 attacking_side) const
     MAKE_SURE(Verification::IsSideValid(attacking_side));
     MAKE_SURE(IsOk());
 
-    // pawns
-    if(attacking_side == ESide::white) {
-        if(b_[sq - 11] == wp || b_[sq - 9] == wp)
-            return true;
-    } else {
-        if(b_[sq + 11] == bp || b_[sq + 9] == bp)
-            return true;
-    }
+    const auto sq64 = ESquare::Sq64(sq);
+    const auto offset = attacking_side == ESide::white ? 0 : 6;
+    const auto occupancy = occupancy_[ESide::both].Get();
+
+    // pawns, looked up from the attacked square with the defender's pawn pattern
+    if(FBitboard::PawnAttacks(attacking_side ^ 1, sq64) & pieces_[wp + offset].Get())
+        return true;
 
     // knights
-    for(auto dir : piece_infos[wn].MoveDirections) {
-        const auto p = b_[sq + dir];
-        if(p != ESquare::offboard && piece_infos[p].bIsKnight && piece_infos[p].Side == attacking_side)
-            return true;
-    }
+    if(FBitboard::KnightAttacks(sq64) & pieces_[wn + offset].Get())
+        return true;
+
+    // kings
+    if(FBitboard::KingAttacks(sq64) & pieces_[wk + offset].Get())
+        return true;
+
+    // bishops & queens
+    const auto queens = pieces_[wq + offset].Get();
+    if(FBitboard::BishopAttacks(sq64, occupancy) & (pieces_[wb + offset].Get() | queens))
+        return true;
 
     // rooks & queens
-    for(auto dir : piece_infos[wr].MoveDirections) {
-        auto sqq = sq + dir;
-        auto piece = b_[sqq];
-        while(piece != ESquare::offboard) {
-            if(piece != empty) {
-                if(piece_infos[piece].bIsRookOrQueen && piece_infos[piece].Side == attacking_side)
-                    return true;
-                break;
-            }
-            sqq += dir;
-            piece = b_[sqq];
-        }
+    if(FBitboard::RookAttacks(sq64, occupancy) & (pieces_[wr + offset].Get() | queens))
+        return true;
+
+    return false;
+}
+
+uint64 UBoard::AttackersTo(const uint32 sq64, const uint8 attacking_side, const uint64 occupancy) const
+{
+    const auto offset = attacking_side == ESide::white ? 0 : 6;
+    const auto queens = pieces_[wq + offset].Get();
+
+    return (FBitboard::PawnAttacks(attacking_side ^ 1, sq64) & pieces_[wp + offset].Get())
+        | (FBitboard::KnightAttacks(sq64) & pieces_[wn + offset].Get())
+        | (FBitboard::KingAttacks(sq64) & pieces_[wk + offset].Get())
+        | (FBitboard::BishopAttacks(sq64, occupancy) & (pieces_[wb + offset].Get() | queens))
+        | (FBitboard::RookAttacks(sq64, occupancy) & (pieces_[wr + offset].Get() | queens));
+}
+
+int32 UBoard::See(const FMove& m) const
+{
+    const auto from = ESquare::Sq64(m.From());
+    const auto to = ESquare::Sq64(m.To());
+    auto occupancy = occupancy_[ESide::both].Get() ^ 1ULL << from;
+
+    int32 gains[32];
+    gains[0] = piece_infos[b_[m.To()]].Value;
+    auto on_square = piece_infos[b_[m.From()]].Value;
+    if(m.IsEnPassant()) {
+        gains[0] = piece_infos[wp].Value;
+        occupancy ^= 1ULL << (side_ == ESide::white ? to - 8 : to + 8);
+    }
+    if(m.IsPromoted()) {
+        on_square = piece_infos[m.PromotedPiece()].Value;
+        gains[0] += on_square - piece_infos[wp].Value;
     }
 
-    // bishops & queens
-    for(auto dir : piece_infos[wb].MoveDirections) {
-        auto sqq = sq + dir;
-        auto piece = b_[sqq];
-        while(piece != ESquare::offboard) {
-            if(piece != empty) {
-                if(piece_infos[piece].bIsBishopOrQueen && piece_infos[piece].Side == attacking_side)
-                    return true;
-                break;
-            }
-            sqq += dir;
-            piece = b_[sqq];
+    // x-ray attackers show up as the pieces in front of them leave the occupancy
+    auto attackers = (AttackersTo(to, ESide::white, occupancy) | AttackersTo(to, ESide::black, occupancy)) & occupancy;
+    auto side = side_ ^ 1;
+    auto depth = 0;
+    while(depth < 31) {
+        const auto side_attackers = attackers & occupancy_[side].Get();
+        if(side_attackers == 0)
+            break;
+
+        const auto offset = side == ESide::white ? 0 : 6;
+        auto piece = wp + offset;
+        while((side_attackers & pieces_[piece].Get()) == 0)
+            piece++;
+
+        // the king can only take last
+        if(piece_infos[piece].bIsKing && (attackers & occupancy_[side ^ 1].Get()))
+            break;
+
+        depth++;
+        gains[depth] = on_square - gains[depth - 1];
+        // the capture loses even if it stays unanswered, so it is not made
+        if(FMath::Max(-gains[depth - 1], gains[depth]) < 0) {
+            depth--;
+            break;
         }
-    }
 
-    // kings
-    for(auto dir : piece_infos[wk].MoveDirections) {
-        const auto piece = b_[sq + dir];
-        if(piece != ESquare::offboard && piece_infos[piece].bIsKing && piece_infos[piece].Side == attacking_side)
-            return true;
+        const auto piece_bb = side_attackers & pieces_[piece].Get();
+        occupancy ^= piece_bb & (~piece_bb + 1);
+        attackers = (AttackersTo(to, ESide::white, occupancy) | AttackersTo(to, ESide::black, occupancy)) & occupancy;
+        on_square = piece_infos[piece].Value;
+        side ^= 1;
     }
 
-    return false;
+    // either side may stop recapturing when that is better for them
+    for(; depth > 0; depth--)
+        gains[depth - 1] = -FMath::Max(-gains[depth - 1], gains[depth]);
+
+    return gains[0];
 }
 
-bool UBoard::HasRepetition()
+bool UBoard::HasRepetition() const
 {
-    for(auto i = history_.Num() - fifty_move_counter_; i < history_.Num() - 1; ++i) {
+    // a position can only repeat with the same side to move, every second ply back
+    const auto window = FMath::Min(fifty_move_counter_, plies_since_null_);
+    const auto first = FMath::Max(history_count_ - int32(window), 0);
+    for(auto i = history_count_ - 2; i >= first; i -= 2) {
         if(history_[i].pos_key == pos_key_)
             return true;
     }
@@ -553,8 +767,9 @@ bool UBoard::IsDrawByMaterial() const
 bool UBoard::HasTrifoldRepetition() const
 {
     auto rep_count = 0;
-    for(auto& h : history_) {
-        if(h.pos_key == pos_key_)
+    const auto first = FMath::Max(history_count_ - int32(fifty_move_counter_), 0);
+    for(auto i = history_count_ - 2; i >= first; i -= 2) {
+        if(history_[i].pos_key == pos_key_)
             rep_count++;
     }
     return rep_count >= 2;
@@ -570,7 +785,7 @@ void UBoard::AddPiece(const uint32 sq, const uint32 piece)
     MAKE_SURE(Verification::IsSquareOnBoard(sq));
     MAKE_SURE(Verification::IsPieceValid(piece));
 
-    const auto piece_info = piece_infos[piece];
+    const auto& piece_info = piece_infos[piece];
     HASH_PIECE(piece, sq);
     b_[sq] = piece;
 
@@ -581,11 +796,19 @@ void UBoard::AddPiece(const uint32 sq, const uint32 piece)
         else
             n_minor_pieces_[piece_info.Side]++;
     } else {
+        HASH_PAWN(piece, sq);
         pawns_[piece_info.Side].SetSquare(ESquare::Sq64(sq));
         pawns_[ESide::both].SetSquare(ESquare::Sq64(sq));
     }
     material_score_[piece_info.Side] += piece_info.Value;
-    piece_locations_[piece].Add(sq);
+    piece_slots_[sq] = piece_locations_[piece].Add(sq);
+
+    const auto sq64 = ESquare::Sq64(sq);
+    middlegame_score_ += PieceSquare::GetMiddlegameScore(piece, sq64);
+    endgame_score_ += PieceSquare::GetEndgameScore(piece, sq64);
+    pieces_[piece].SetSquare(sq64);
+    occupancy_[piece_info.Side].SetSquare(sq64);
+    occupancy_[ESide::both].SetSquare(sq64);
 }
 
 void UBoard::MovePiece(const uint32 from, const uint32 to)
@@ -594,26 +817,37 @@ void UBoard::MovePiece(const uint32 from, const uint32 to)
     MAKE_SURE(Verification::IsSquareOnBoard(to));
 
     const auto piece = b_[from];
-    const auto piece_info = piece_infos[piece];
+    const auto& piece_info = piece_infos[piece];
 
     HASH_PIECE(piece, from);
     b_[from] = EPieceType::empty;
     HASH_PIECE(piece, to);
     b_[to] = piece;
 
-    if(piece_info.bIsPawn) {
-        pawns_[piece_info.Side].ClearSquare(ESquare::Sq64(from));
-        pawns_[ESide::both].ClearSquare(ESquare::Sq64(from));
-        pawns_[piece_info.Side].SetSquare(ESquare::Sq64(to));
-        pawns_[ESide::both].SetSquare(ESquare::Sq64(to));
-    }
+    const auto from64 = ESquare::Sq64(from);
+    const auto to64 = ESquare::Sq64(to);
+    middlegame_score_ += PieceSquare::GetMiddlegameScore(piece, to64) - PieceSquare::GetMiddlegameScore(piece, from64);
+    endgame_score_ += PieceSquare::GetEndgameScore(piece, to64) - PieceSquare::GetEndgameScore(piece, from64);
 
-    for(auto& sq : piece_locations_[piece]) {
-        if(sq == from) {
-            sq = to;
-            break;
-        }
-    }
+    if(piece_info.bIsPawn) {
+        HASH_PAWN(piece, from);
+        HASH_PAWN(piece, to);
+        pawns_[piece_info.Side].ClearSquare(from64);
+        pawns_[ESide::both].ClearSquare(from64);
+        pawns_[piece_info.Side].SetSquare(to64);
+        pawns_[ESide::both].SetSquare(to64);
+    }
+
+    pieces_[piece].ClearSquare(from64);
+    pieces_[piece].SetSquare(to64);
+    occupancy_[piece_info.Side].ClearSquare(from64);
+    occupancy_[piece_info.Side].SetSquare(to64);
+    occupancy_[ESide::both].ClearSquare(from64);
+    occupancy_[ESide::both].SetSquare(to64);
+
+    const auto slot = piece_slots_[from];
+    piece_locations_[piece][slot] = to;
+    piece_slots_[to] = slot;
 }
 
 void UBoard::ClearPiece(const uint32 sq)
@@ -621,7 +855,7 @@ void UBoard::ClearPiece(const uint32 sq)
     MAKE_SURE(Verification::IsSquareOnBoard(sq));
     MAKE_SURE(IsOk());
     const auto piece = b_[sq];
-    const auto piece_info = piece_infos[piece];
+    const auto& piece_info = piece_infos[piece];
     MAKE_SURE(Verification::IsPieceValid(piece));
 
     HASH_PIECE(piece, sq);
@@ -635,11 +869,21 @@ void UBoard::ClearPiece(const uint32 sq)
         else
             n_minor_pieces_[piece_info.Side]--;
     } else {
+        HASH_PAWN(piece, sq);
         pawns_[piece_info.Side].ClearSquare(ESquare::Sq64(sq));
         pawns_[ESide::both].ClearSquare(ESquare::Sq64(sq));
     }
 
-    piece_locations_[piece].RemoveSingleSwap(sq);
+    const auto slot = piece_slots_[sq];
+    const auto moved = piece_locations_[piece].RemoveAtSwap(slot);
+    piece_slots_[moved] = slot;
+
+    const auto sq64 = ESquare::Sq64(sq);
+    middlegame_score_ -= PieceSquare::GetMiddlegameScore(piece, sq64);
+    endgame_score_ -= PieceSquare::GetEndgameScore(piece, sq64);
+    pieces_[piece].ClearSquare(sq64);
+    occupancy_[piece_info.Side].ClearSquare(sq64);
+    occupancy_[ESide::both].ClearSquare(sq64);
 }
 
 #ifdef DEBUG
@@ -673,6 +917,8 @@ bool UBoard::IsOk() const
     uint32 n_major_pieces[2] = {0, 0};
     uint32 n_minor_pieces[2] = {0, 0};
     uint32 material_score[2] = {0, 0};
+    auto middlegame_score = 0;
+    auto endgame_score = 0;
 
     FBitboard pawns[3];
     pawns[0] = pawns_[0];
@@ -689,7 +935,10 @@ bool UBoard::IsOk() const
     for(uint32 sq64 = 0; sq64 < n_board_squares; sq64++) {
         const auto sq120 = ESquare::Sq120(sq64);
         const auto piece = b_[sq120];
-        const auto piece_info = piece_infos[piece];
+        if(piece == EPieceType::empty)
+            continue;
+
+        const auto& piece_info = piece_infos[piece];
         piece_count[piece]++;
 
         const auto side = piece_info.Side;
@@ -702,6 +951,8 @@ bool UBoard::IsOk() const
         }
 
         material_score[side] += piece_info.Value;
+        middlegame_score += PieceSquare::GetMiddlegameScore(piece, sq64);
+        endgame_score += PieceSquare::GetEndgameScore(piece, sq64);
     }
 
     for(uint32 p = EPieceType::wp; p <= EPieceType::bk; ++p) {
@@ -729,8 +980,19 @@ bool UBoard::IsOk() const
             || b_[ESquare::Sq120(sq64)] == EPieceType::bp);
     }
 
+    for(uint32 p = EPieceType::wp; p <= EPieceType::bk; ++p) {
+        MAKE_SURE(pieces_[p].Count() == piece_locations_[p].Num());
+        for(auto i = 0; i < piece_locations_[p].Num(); ++i)
+            MAKE_SURE(piece_slots_[piece_locations_[p][i]] == i);
+        for(auto sq : piece_locations_[p])
+            MAKE_SURE(pieces_[p].Get() & 1ULL << ESquare::Sq64(sq));
+    }
+    MAKE_SURE((occupancy_[ESide::white].Get() | occupancy_[ESide::black].Get()) == occupancy_[ESide::both].Get());
+    MAKE_SURE((occupancy_[ESide::white].Get() & occupancy_[ESide::black].Get()) == 0);
+
     MAKE_SURE(material_score[ESide::white] == material_score_[ESide::white]
         && material_score[ESide::black] == material_score_[ESide::black]);
+    MAKE_SURE(middlegame_score == middlegame_score_ && endgame_score == endgame_score_);
     MAKE_SURE(n_minor_pieces[ESide::white] == n_minor_pieces_[ESide::white]
         && n_minor_pieces[ESide::black] == n_minor_pieces_[ESide::black]);
     MAKE_SURE(n_major_pieces[ESide::white] == n_major_pieces_[ESide::white]
@@ -739,6 +1001,7 @@ bool UBoard::IsOk() const
         && n_big_pieces[ESide::black] == n_big_pieces_[ESide::black]);
     MAKE_SURE(side_ == ESide::white || side_ == ESide::black);
     MAKE_SURE(GeneratePositionKey() == pos_key_);
+    MAKE_SURE(GeneratePawnKey() == pawn_key_);
 
     MAKE_SURE(en_passant_sq_ == ESquare::no_sq ||
         ESquare::Rank(en_passant_sq_) == ERank::rank_6 && side_ == ESide::white ||
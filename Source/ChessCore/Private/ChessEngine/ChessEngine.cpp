@@ -0,0 +1,558 @@
+// Copyright 2018 Emre Simsirli
+
+#include "ChessEngine.h"
+#include "Bitboard.h"
+#include "Board.h"
+#include "PosKey.h"
+#include "PieceSquare.h"
+#include "Square.h"
+#include "Debug.h"
+#include "Search.h"
+#include "TranspositionTable.h"
+#include "MoveExplorer.h"
+#include "OpeningBook.h"
+#include "Side.h"
+#include "HAL/PlatformTime.h"
+#include "Async.h"
+#include "Util/Log.h"
+
+namespace
+{
+    struct FPerftPosition
+    {
+        const TCHAR* Fen;
+        // leaf nodes for depth 1.., zero where the suite stops
+        int64 Nodes[6];
+    };
+
+    const FPerftPosition perft_suite[] = {
+        {TEXT("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"),
+            {20, 400, 8902, 197281, 4865609, 119060324}},
+        {TEXT("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"),
+            {48, 2039, 97862, 4085603, 193690690, 0}},
+        {TEXT("8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1"),
+            {14, 191, 2812, 43238, 674624, 11030083}},
+        {TEXT("r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1"),
+            {6, 264, 9467, 422333, 15833292, 706045033}},
+        {TEXT("rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8"),
+            {44, 1486, 62379, 2103487, 89941194, 0}},
+        {TEXT("r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10"),
+            {46, 2079, 89890, 3894594, 164075551, 0}},
+    };
+
+    const TCHAR* bench_fens[] = {
+        TEXT("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"),
+        TEXT("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"),
+        TEXT("8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1"),
+        TEXT("r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10"),
+        TEXT("r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4"),
+        TEXT("rnbqkb1r/pp1p1ppp/4pn2/2p5/2PP4/2N5/PP2PPPP/R1BQKBNR w KQkq - 0 4"),
+        TEXT("r2q1rk1/pp2bppp/2n1pn2/3p4/3P4/2NBPN2/PP3PPP/R2Q1RK1 w - - 0 10"),
+        TEXT("2r3k1/pp3ppp/4p3/3pP3/3P4/P4N2/1P3PPP/2R3K1 w - - 0 25"),
+        TEXT("8/5pk1/6p1/7p/2R4P/6P1/r4PK1/8 b - - 0 40"),
+        TEXT("6k1/5p2/6p1/8/7p/8/6PP/6K1 b - - 0 1"),
+        TEXT("8/8/4k3/8/2p5/8/B2P2K1/8 w - - 0 1"),
+        TEXT("4rrk1/pp1n3p/3q2pQ/2p1pb2/2PP4/2P3N1/P2B2PP/4RRK1 b - - 7 19"),
+    };
+}
+
+void UChessEngine::Initialize()
+{
+    // function local statics are initialized exactly once, even with concurrent callers
+    static const auto initialized = []() -> bool
+    {
+        LOGI("engine initialization starting");
+        ESquare::Initialize();
+        FBitboard::Initialize();
+        PosKey::Initialize();
+        PieceSquare::Initialize();
+        UMoveGenerator::Initialize();
+        UMoveExplorer::Initialize();
+        LOGI("engine initialization complete");
+        return true;
+    }();
+    (void)initialized;
+}
+
+void UChessEngine::CheckGameOver() const
+{
+    if(board_->DoesViolateFiftyMoveRule()) {
+        LOGI("fifty move draw claimed");
+        UpdateGameStateDelegate.Execute(EGameState::draw, EGameOverReason::fifty_move);
+	} else if(board_->HasTrifoldRepetition()) {
+        LOGI("trifold repetition draw claimed");
+        UpdateGameStateDelegate.Execute(EGameState::draw, EGameOverReason::trifold_repetition);
+    } else if(board_->IsDrawByMaterial()) {
+        LOGI("insufficent material draw claimed");
+        UpdateGameStateDelegate.Execute(EGameState::draw, EGameOverReason::insufficent_material);
+    } else {
+        if(move_generator_->HasLegalMove()) {
+            UpdateGameStateDelegate.Execute(EGameState::not_over, EGameOverReason::none);
+            return;
+        }
+
+        if(board_->IsInCheck()) {
+            switch(board_->GetSide()) {
+                case ESide::white:
+                    LOGI("mate claimed for black");
+                    UpdateGameStateDelegate.Execute(EGameState::mate, EGameOverReason::mate_black);
+                    break;
+                case ESide::black:
+                    LOGI("mate claimed for white");
+                    UpdateGameStateDelegate.Execute(EGameState::mate, EGameOverReason::mate_white);
+                    break;
+                default: break;
+            }
+        } else {
+            LOGI("stalemate draw claimed");
+            UpdateGameStateDelegate.Execute(EGameState::draw, EGameOverReason::stalemate);
+        }
+    }
+}
+
+UChessEngine::UChessEngine()
+{
+    Initialize();
+
+    // the class default object never searches, no hash table or thread for it
+    if(HasAnyFlags(RF_ClassDefaultObject))
+        return;
+
+    board_ = NewObject<UBoard>();
+    move_generator_ = NewObject<UMoveGenerator>();
+    move_explorer_ = NewObject<UMoveExplorer>();
+    hash_table_ = NewObject<UTranspositionTable>();
+    hash_table_->Resize(SearchParams.HashSize);
+    opening_book_ = new FOpeningBook();
+    move_explorer_thread_ = new FMoveExplorerThread(this);
+    SearchInfo = new FSearchInfo();
+
+    move_generator_->SetContext(this, board_, SearchInfo);
+    move_explorer_->SetContext(this, board_, move_generator_, SearchInfo);
+}
+
+UChessEngine::~UChessEngine()
+{
+    if(move_explorer_thread_) {
+        move_explorer_thread_->Stop();
+        delete move_explorer_thread_;
+    }
+
+    for(auto* helper : helper_threads_) {
+        helper->Stop();
+        delete helper;
+    }
+
+    delete opening_book_;
+    delete SearchInfo;
+}
+
+void UChessEngine::Set(FString& fen) const
+{
+    board_->Set(fen);
+}
+
+bool UChessEngine::MakeMove(FMove& move) const
+{
+    LOGI("%s making move %s", 
+		*FString(board_->GetSide() == ESide::white ? "white" : "black"), 
+		*move.ToString());
+
+    if(!board_->MakeMove(move)) {
+        LOGW("move %s was not made", *move.ToString());
+        return false;
+    }
+    CheckGameOver();
+    return true;
+}
+
+void UChessEngine::TakeMove() const
+{
+    board_->TakeMove();
+}
+
+TArray<FMove> UChessEngine::GenerateMoves(const uint32 sq) const
+{
+    FMoveList moves;
+    move_generator_->GenerateLegalMoves(sq, moves);
+    return TArray<FMove>(moves.Moves, moves.Num());
+}
+
+void UChessEngine::Search()
+{
+    FMove book_move;
+    if(ProbeOpeningBook(book_move)) {
+        // handed over the same way the search thread hands over its move
+        auto* engine = this;
+        AsyncTask(ENamedThreads::GameThread, [engine, book_move]() -> void
+        {
+            engine->MoveFoundDelegate.Execute(book_move);
+        });
+        return;
+    }
+
+    hash_table_->Resize(SearchParams.HashSize);
+    UpdateHelperThreads();
+    move_explorer_thread_->StartSearch();
+}
+
+FMove UChessEngine::FindBestMove()
+{
+    FMove book_move;
+    if(ProbeOpeningBook(book_move))
+        return book_move;
+
+    hash_table_->Resize(SearchParams.HashSize);
+    UpdateHelperThreads();
+    return move_explorer_->Search();
+}
+
+bool UChessEngine::ProbeOpeningBook(FMove& move)
+{
+    if(!SearchParams.UseOpeningBook)
+        return false;
+
+    if(opening_book_->GetPath() != SearchParams.OpeningBook)
+        opening_book_->Open(SearchParams.OpeningBook);
+    return opening_book_->Probe(board_, move_generator_, move);
+}
+
+void UChessEngine::StopSearch() const
+{
+    SearchInfo->bStopRequested = true;
+}
+
+void UChessEngine::ClearHash() const
+{
+    hash_table_->Clear();
+}
+
+bool UChessEngine::ParseMove(const FString& str, FMove& move) const
+{
+    FMoveList moves;
+    move_generator_->GenerateLegalMoves(moves);
+    for(const auto& m : moves) {
+        if(m.ToString() == str) {
+            move = m;
+            return true;
+        }
+    }
+    return false;
+}
+
+TArray<FMove> UChessEngine::GetPrincipalVariation(const int32 depth) const
+{
+    return hash_table_->GetLine(board_, move_generator_, depth);
+}
+
+uint8 UChessEngine::GetSide() const
+{
+    return board_->GetSide();
+}
+
+FString UChessEngine::ThreadScaling(const int32 depth, const int32 max_threads)
+{
+    // scaling is measured with the hash size the engine plays with
+    const auto hash_size = SearchParams.HashSize;
+    return RunBenchmark([this, depth, max_threads, hash_size]() -> FString
+    {
+        SearchParams.Depth = depth;
+        SearchParams.HashSize = hash_size;
+        hash_table_->Resize(SearchParams.HashSize);
+
+        FString report;
+        for(auto threads = 1; threads <= max_threads; threads *= 2) {
+            SearchParams.HelperThreads = threads - 1;
+            UpdateHelperThreads();
+            hash_table_->Clear();
+
+            const auto start = FPlatformTime::Seconds();
+            const auto best_move = move_explorer_->Search();
+            const auto elapsed = FPlatformTime::Seconds() - start;
+
+            const auto nodes = SearchInfo->AllThreadsVisitedNodes;
+            report += FString::Printf(TEXT("threads %2d depth %d nodes %lld time %.3f nps %.0f move %s\n"),
+                threads, depth, nodes, elapsed, elapsed > 0 ? nodes / elapsed : 0, *best_move.ToString());
+        }
+        return report;
+    });
+}
+
+void UChessEngine::UpdateHelperThreads()
+{
+    const auto n_helpers = FMath::Max(0, SearchParams.HelperThreads);
+    while(helper_threads_.Num() > n_helpers) {
+        auto* helper = helper_threads_.Pop();
+        helper->Stop();
+        delete helper;
+    }
+
+    while(helper_threads_.Num() < n_helpers)
+        helper_threads_.Add(new FMoveExplorerHelperThread(this, helper_threads_.Num()));
+}
+
+FString UChessEngine::InstanceScaling(const int32 depth, const int32 max_instances)
+{
+    TArray<UChessEngine*> engines;
+    for(auto i = 0; i < max_instances; ++i) {
+        auto* engine = NewObject<UChessEngine>();
+        engine->SearchParams.Depth = depth;
+        engine->SearchParams.TimeSet = 0;
+        engine->SearchParams.HelperThreads = 0;
+        // the same small hash the other benchmarks use, sixteen engines at the
+        // default size would take a gigabyte
+        engine->SearchParams.HashSize = 16;
+        engine->hash_table_->Resize(engine->SearchParams.HashSize);
+        engine->AddToRoot();
+        engines.Add(engine);
+    }
+
+    FString report;
+    double base_nps = 0;
+    for(auto instances = 1; instances <= max_instances; instances *= 2) {
+        TArray<TFuture<void>> searches;
+
+        const auto start = FPlatformTime::Seconds();
+        for(auto i = 0; i < instances; ++i) {
+            auto* engine = engines[i];
+            engine->hash_table_->Clear();
+            searches.Add(Async<void>(EAsyncExecution::Thread, [engine]() -> void
+            {
+                engine->move_explorer_->Search();
+            }));
+        }
+
+        int64 nodes = 0;
+        for(auto i = 0; i < instances; ++i) {
+            searches[i].Wait();
+            nodes += engines[i]->SearchInfo->AllThreadsVisitedNodes;
+        }
+        const auto elapsed = FPlatformTime::Seconds() - start;
+
+        const auto nps = elapsed > 0 ? nodes / elapsed : 0;
+        if(instances == 1)
+            base_nps = nps;
+
+        report += FString::Printf(TEXT("instances %2d depth %d nodes %lld time %.3f nps %.0f scaling %.2f\n"),
+            instances, depth, nodes, elapsed, nps, base_nps > 0 ? nps / base_nps : 0);
+    }
+
+    for(auto* engine : engines)
+        engine->RemoveFromRoot();
+    return report;
+}
+
+FString UChessEngine::Bench(const int32 depth)
+{
+    return RunBenchmark([this, depth]() -> FString
+    {
+        SearchParams.Depth = depth;
+
+        FString report;
+        int64 total = 0;
+        int64 null_window_researches = 0;
+        int64 aspiration_researches = 0;
+        int64 pawn_hash_probes = 0;
+        int64 pawn_hash_hits = 0;
+        int64 eval_cache_hits = 0;
+        int64 eval_cache_misses = 0;
+        auto total_time = 0.0;
+        auto index = 0;
+
+        for(auto* fen : bench_fens) {
+            board_->Set(fen);
+            hash_table_->Resize(SearchParams.HashSize);
+            hash_table_->Clear();
+            move_explorer_->ClearCaches();
+
+            const auto start = FPlatformTime::Seconds();
+            const auto best_move = FindBestMove();
+            const auto elapsed = FPlatformTime::Seconds() - start;
+
+            const auto nodes = SearchInfo->AllThreadsVisitedNodes;
+            total += nodes;
+            total_time += elapsed;
+            null_window_researches += SearchInfo->NullWindowResearches;
+            aspiration_researches += SearchInfo->AspirationResearches;
+            pawn_hash_probes += SearchInfo->PawnHashProbes;
+            pawn_hash_hits += SearchInfo->PawnHashHits;
+            eval_cache_hits += SearchInfo->EvalCacheHits;
+            eval_cache_misses += SearchInfo->EvalCacheMisses;
+
+            report += FString::Printf(TEXT("position %d nodes %lld time %.3f bestmove %s\n"),
+                ++index, nodes, elapsed, *best_move.ToString());
+        }
+
+        report += FString::Printf(TEXT("researches null window %lld aspiration %lld\n"),
+            null_window_researches, aspiration_researches);
+        report += FString::Printf(TEXT("pawn hash hits %lld of %lld, %.1f%%\n"),
+            pawn_hash_hits, pawn_hash_probes, pawn_hash_probes > 0 ? 100.0 * pawn_hash_hits / pawn_hash_probes : 0);
+        report += FString::Printf(TEXT("eval cache hits %lld misses %lld\n"), eval_cache_hits, eval_cache_misses);
+        report += FString::Printf(TEXT("bench depth %d nodes %lld time %.3f nps %.0f\n"),
+            depth, total, total_time, total_time > 0 ? total / total_time : 0);
+        return report;
+    });
+}
+
+FString UChessEngine::CompareCopyMake(const int32 perft_depth, const int32 search_depth)
+{
+    const auto use_copy_make = SearchParams.UseCopyMake;
+    FString report;
+    for(const auto copy_make : {false, true}) {
+        report += copy_make ? TEXT("copy-make\n") : TEXT("make/unmake\n");
+
+        // perft makes its moves on the board directly, the search sets the mode itself
+        report += RunBenchmark([this, copy_make, perft_depth]() -> FString
+        {
+            int64 nodes = 0;
+            auto time = 0.0;
+            board_->SetCopyMake(copy_make);
+            for(const auto& position : perft_suite) {
+                board_->Set(position.Fen);
+                const auto start = FPlatformTime::Seconds();
+                nodes += Perft(perft_depth);
+                time += FPlatformTime::Seconds() - start;
+            }
+            board_->SetCopyMake(false);
+            return FString::Printf(TEXT("perft depth %d nodes %lld time %.3f nps %.0f\n"),
+                perft_depth, nodes, time, time > 0 ? nodes / time : 0);
+        });
+
+        SearchParams.UseCopyMake = copy_make;
+        report += Bench(search_depth);
+    }
+
+    SearchParams.UseCopyMake = use_copy_make;
+    return report;
+}
+
+FString UChessEngine::RunBenchmark(const TFunction<FString()>& benchmark)
+{
+    // the benchmarks set positions of their own, the game is put back afterwards
+    FPosition saved_position;
+    TArray<FUndo> saved_history;
+    board_->SaveTo(saved_position, saved_history);
+    const auto params = SearchParams;
+
+    // helpers, the clock, the hash size and the book would all make the node count vary
+    SearchParams.TimeSet = 0;
+    SearchParams.HelperThreads = 0;
+    SearchParams.HashSize = 16;
+    SearchParams.UseOpeningBook = false;
+    UpdateHelperThreads();
+
+    const auto report = benchmark();
+
+    SearchParams = params;
+    UpdateHelperThreads();
+    board_->RestoreFrom(saved_position, saved_history);
+    return report;
+}
+
+void UChessEngine::GetPieces(const TFunction<void(uint32, uint32)>& on_piece) const
+{
+    const auto* piece_locs = board_->GetPieceLocations(); 
+    for(uint32 piece = 1; piece < n_pieces; ++piece)
+        for(auto sq : piece_locs[piece])
+            on_piece(piece, sq);
+}
+
+void UChessEngine::Perft(const int32 depth, int64* leaf_nodes) const
+{
+    if(depth == 0) {
+        ++*leaf_nodes;
+        return;
+    }
+
+    FMoveList moves;
+    move_generator_->GenerateLegalMoves(moves);
+
+    // the moves are legal, so the last ply only needs counting
+    if(depth == 1) {
+        *leaf_nodes += moves.Num();
+        return;
+    }
+
+    for(auto& m : moves) {
+        board_->MakeMove(m);
+        Perft(depth - 1, leaf_nodes);
+        board_->TakeMove();
+    }
+}
+
+int64 UChessEngine::Perft(const int32 depth) const
+{
+    int64 leaf_nodes = 0;
+    Perft(depth, &leaf_nodes);
+    return leaf_nodes;
+}
+
+FString UChessEngine::Divide(const int32 depth) const
+{
+    FString report;
+    int64 total = 0;
+    const auto start = FPlatformTime::Seconds();
+
+    FMoveList moves;
+    move_generator_->GenerateLegalMoves(moves);
+    for(auto& m : moves) {
+        int64 leaf_nodes = 0;
+        board_->MakeMove(m);
+        Perft(depth - 1, &leaf_nodes);
+        board_->TakeMove();
+
+        total += leaf_nodes;
+        report += FString::Printf(TEXT("%s: %lld\n"), *m.ToString(), leaf_nodes);
+    }
+
+    const auto elapsed = FPlatformTime::Seconds() - start;
+    report += FString::Printf(TEXT("depth %d nodes %lld time %.3f nps %.0f\n"),
+        depth, total, elapsed, elapsed > 0 ? total / elapsed : 0);
+    return report;
+}
+
+FString UChessEngine::PerftSuite(const int32 max_depth) const
+{
+    // the suite overwrites the position, so keep the game's one aside
+    FPosition saved_position;
+    TArray<FUndo> saved_history;
+    board_->SaveTo(saved_position, saved_history);
+
+    FString report;
+    auto passed = true;
+    int64 total = 0;
+    auto total_time = 0.0;
+
+    auto index = 0;
+    for(const auto& position : perft_suite) {
+        ++index;
+        board_->Set(position.Fen);
+
+        const int32 n_depths = ARRAY_COUNT(position.Nodes);
+        for(auto depth = 1; depth <= max_depth && depth <= n_depths; ++depth) {
+            const auto expected = position.Nodes[depth - 1];
+            if(expected == 0)
+                break;
+
+            const auto start = FPlatformTime::Seconds();
+            const auto nodes = Perft(depth);
+            const auto elapsed = FPlatformTime::Seconds() - start;
+
+            const auto ok = nodes == expected;
+            passed &= ok;
+            total += nodes;
+            total_time += elapsed;
+
+            report += FString::Printf(TEXT("position %d depth %d nodes %lld expected %lld %s time %.3f nps %.0f\n"),
+                index, depth, nodes, expected, ok ? TEXT("ok") : TEXT("FAILED"),
+                elapsed, elapsed > 0 ? nodes / elapsed : 0);
+        }
+    }
+
+    report += FString::Printf(TEXT("perft suite %s nodes %lld time %.3f nps %.0f\n"),
+        passed ? TEXT("passed") : TEXT("FAILED"), total, total_time,
+        total_time > 0 ? total / total_time : 0);
+
+    board_->RestoreFrom(saved_position, saved_history);
+    return report;
+}
@@ -0,0 +1,38 @@
+// Copyright 2018 Emre Simsirli
+
+#include "EvalHashTable.h"
+#include "Consts.h"
+#include "Debug.h"
+
+// one word per entry, 512 kb in all
+#define EVAL_TABLE_ENTRIES (1 << 16)
+#define SCORE_MASK 0xFFFFULL
+
+FEvalHashTable::FEvalHashTable()
+{
+    entries_.SetNum(EVAL_TABLE_ENTRIES);
+    Clear();
+}
+
+bool FEvalHashTable::Probe(const uint64 pos_key, int32& score) const
+{
+    const auto entry = entries_[pos_key & (EVAL_TABLE_ENTRIES - 1)];
+    if(((entry ^ pos_key) & ~SCORE_MASK) != 0)
+        return false;
+
+    score = static_cast<int16>(entry & SCORE_MASK);
+    return true;
+}
+
+void FEvalHashTable::Store(const uint64 pos_key, const int32 score)
+{
+    // fits 16 bits
+    MAKE_SURE(score > -infinite_score && score < infinite_score);
+    entries_[pos_key & (EVAL_TABLE_ENTRIES - 1)] = (pos_key & ~SCORE_MASK) | static_cast<uint16>(score);
+}
+
+void FEvalHashTable::Clear()
+{
+    for(auto& entry : entries_)
+        entry = 0;
+}
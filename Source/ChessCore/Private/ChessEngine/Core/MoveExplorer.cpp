@@ -0,0 +1,729 @@
+// Copyright 2018 Emre Simsirli
+
+#include "MoveExplorer.h"
+#include "Board.h"
+#include "Debug.h"
+#include "Side.h"
+#include "PieceInfo.h"
+#include "Search.h"
+#include "MovePicker.h"
+#include "PawnHashTable.h"
+#include "EvalHashTable.h"
+#include "TranspositionTable.h"
+#include "RunnableThread.h"
+#include "ThreadSafeBool.h"
+#include "Event.h"
+#include "ChessEngine.h"
+#include "Async.h"
+#include "Util/Log.h"
+#include "HAL/PlatformTime.h"
+
+// too shallow below this for the reduced null move search to pay off
+#define NULL_MOVE_MIN_DEPTH 3
+// half width of the first aspiration window, doubled on every fail
+#define ASPIRATION_WINDOW 25
+// earlier iterations are too unstable to guess the score from
+#define ASPIRATION_MIN_DEPTH 4
+// scores beyond this are mate scores, pruning must not touch them
+#define IS_MATE (mate_score - max_depth)
+// static eval this far above beta at shallow depth is not going to come down
+#define REVERSE_FUTILITY_MAX_DEPTH 3
+#define REVERSE_FUTILITY_MARGIN 120
+// static eval this far below alpha is only checked by a quiescence search
+#define RAZORING_MAX_DEPTH 2
+#define RAZORING_MARGIN 300
+#define FUTILITY_MAX_DEPTH 3
+// moves before this in the picker order are never reduced
+#define LMR_MIN_MOVES 3
+#define LMR_MIN_DEPTH 3
+// game phase weights of the pieces, kings do not count. majors are rooks and queens
+#define MINOR_PHASE 1
+#define MAJOR_PHASE 2
+#define TOTAL_PHASE 20
+// pawn structure penalties, middlegame and endgame
+#define DOUBLED_PAWN_MG 10
+#define DOUBLED_PAWN_EG 20
+#define ISOLATED_PAWN_MG 10
+#define ISOLATED_PAWN_EG 15
+#define BACKWARD_PAWN_MG 8
+#define BACKWARD_PAWN_EG 10
+
+namespace
+{
+    // quiet moves that cannot raise the eval by this much at the given depth are skipped
+    const int32 futility_margins[FUTILITY_MAX_DEPTH + 1] = {0, 200, 300, 500};
+    // late move reductions by [depth][move number]
+    uint32 lmr_reductions[max_depth][max_position_moves];
+
+    // passed pawn bonuses by relative rank
+    const int32 passed_pawn_mg[8] = {0, 5, 10, 15, 25, 40, 60, 0};
+    const int32 passed_pawn_eg[8] = {0, 10, 20, 35, 60, 90, 130, 0};
+
+    uint64 file_masks[8];
+    uint64 adjacent_file_masks[8];
+    // squares in front of a pawn on its own and the adjacent files
+    uint64 passed_masks[2][n_board_squares];
+    // squares on the adjacent files level with or behind a pawn
+    uint64 support_masks[2][n_board_squares];
+}
+
+void UMoveExplorer::Initialize()
+{
+    // grows with both depth and move number, so late moves in deep searches lose the most
+    for(auto depth = 1; depth < max_depth; depth++)
+        for(auto moves = 1; moves < max_position_moves; moves++)
+            lmr_reductions[depth][moves] = FMath::FloorToInt(
+                .75f + FMath::Loge(depth) * FMath::Loge(moves) / 2.25f);
+
+    for(uint32 file = 0; file < 8; ++file)
+        file_masks[file] = 0x0101010101010101ULL << file;
+
+    for(uint32 file = 0; file < 8; ++file)
+        adjacent_file_masks[file] = (file > 0 ? file_masks[file - 1] : 0) | (file < 7 ? file_masks[file + 1] : 0);
+
+    for(uint32 sq64 = 0; sq64 < n_board_squares; ++sq64) {
+        const auto file = sq64 & 7;
+        const auto rank = sq64 >> 3;
+        const auto files = file_masks[file] | adjacent_file_masks[file];
+
+        passed_masks[ESide::white][sq64] = passed_masks[ESide::black][sq64] = 0;
+        support_masks[ESide::white][sq64] = support_masks[ESide::black][sq64] = 0;
+        for(uint32 r = 0; r < 8; ++r) {
+            const auto rank_mask = 0xFFULL << r * 8;
+            if(r > rank) passed_masks[ESide::white][sq64] |= files & rank_mask;
+            if(r < rank) passed_masks[ESide::black][sq64] |= files & rank_mask;
+            if(r <= rank) support_masks[ESide::white][sq64] |= adjacent_file_masks[file] & rank_mask;
+            if(r >= rank) support_masks[ESide::black][sq64] |= adjacent_file_masks[file] & rank_mask;
+        }
+    }
+}
+
+UMoveExplorer::~UMoveExplorer()
+{
+    delete pawn_table_;
+    delete eval_table_;
+}
+
+void UMoveExplorer::SetContext(UChessEngine* engine, UBoard* board, UMoveGenerator* move_generator,
+                               FSearchInfo* search_info)
+{
+    engine_ = engine;
+    board_ = board;
+    move_generator_ = move_generator;
+    search_info_ = search_info;
+
+    if(pawn_table_ == nullptr)
+        pawn_table_ = new FPawnHashTable();
+    if(eval_table_ == nullptr)
+        eval_table_ = new FEvalHashTable();
+}
+
+void UMoveExplorer::ClearCaches() const
+{
+    pawn_table_->Clear();
+    eval_table_->Clear();
+}
+
+FMove UMoveExplorer::Search() const
+{
+    LOGI("beginning with depth: %d, time set: %d, null cut: %d, helpers: %d",
+        engine_->SearchParams.Depth,
+        engine_->SearchParams.TimeSet,
+        engine_->SearchParams.UseNullCut,
+        engine_->helper_threads_.Num());
+    engine_->hash_table_->NewSearch();
+
+    for(auto* helper : engine_->helper_threads_)
+        helper->StartSearch(board_);
+
+    PrepareSearch();
+    IterativeDeepening(1);
+    // the game goes on with plain make/unmake, its moves are not bound by the search depth
+    board_->SetCopyMake(false);
+
+    // helpers only live as long as the main search
+    const FSearchInfo* best_info = search_info_;
+    search_info_->AllThreadsVisitedNodes = search_info_->TotalVisitedNodes;
+    for(auto* helper : engine_->helper_threads_) {
+        helper->StopSearch();
+
+        const auto* info = helper->GetSearchInfo();
+        search_info_->AllThreadsVisitedNodes += info->TotalVisitedNodes;
+        if(info->CompletedDepth > best_info->CompletedDepth && info->BestMove != FMove::no_move)
+            best_info = info;
+    }
+
+    const auto best_move = best_info->BestMove;
+
+    search_info_->StopTimeActual = FPlatformTime::Seconds();
+    LOGI("best move found: %s, depth %d, took %f secs, actual-set diff %f secs, nodes %lld",
+        *best_move.ToString(), best_info->CompletedDepth,
+        search_info_->StopTimeActual - search_info_->StartTime,
+        search_info_->StopTimeActual - search_info_->StopTimeSet,
+        search_info_->AllThreadsVisitedNodes);
+
+    return best_move;
+}
+
+void UMoveExplorer::SearchAsHelper(const uint32 helper_index) const
+{
+    // odd helpers skip the first iteration so that
+    // threads do not walk the tree in lockstep
+    IterativeDeepening(1 + helper_index % 2);
+}
+
+void UMoveExplorer::PrepareSearch() const
+{
+    search_info_->Clear();
+    board_->ply_ = 0;
+    board_->SetCopyMake(engine_->SearchParams.UseCopyMake);
+
+    search_info_->StartTime = FPlatformTime::Seconds();
+    if(engine_->SearchParams.TimeSet > 0)
+        search_info_->StopTimeSet = search_info_->StartTime + engine_->SearchParams.TimeSet;
+}
+
+void UMoveExplorer::IterativeDeepening(const int32 start_depth) const
+{
+    auto best_score = 0;
+    for(auto depth = start_depth; depth <= engine_->SearchParams.Depth; ++depth) {
+        // search a window around the last score first, and widen
+        // only the side that failed until the score falls inside
+        auto delta = ASPIRATION_WINDOW;
+        auto alpha = -infinite_score;
+        auto beta = infinite_score;
+        if(depth >= ASPIRATION_MIN_DEPTH) {
+            alpha = FMath::Max(best_score - delta, -infinite_score);
+            beta = FMath::Min(best_score + delta, infinite_score);
+        }
+
+        while(true) {
+            best_score = AlphaBeta(alpha, beta, depth, true);
+            if(search_info_->bStopRequested)
+                break;
+
+            if(best_score <= alpha && alpha > -infinite_score)
+                alpha = FMath::Max(alpha - delta, -infinite_score);
+            else if(best_score >= beta && beta < infinite_score)
+                beta = FMath::Min(beta + delta, infinite_score);
+            else
+                break;
+
+            search_info_->AspirationResearches++;
+            delta *= 2;
+        }
+
+        if(search_info_->bStopRequested)
+            break;
+
+        search_info_->CompletedDepth = depth;
+        search_info_->BestMove = search_info_->RootBestMove;
+
+        // progress is only reported by the main search
+        if(search_info_ == engine_->SearchInfo && engine_->IterationCompletedDelegate.IsBound()) {
+            search_info_->AllThreadsVisitedNodes = search_info_->TotalVisitedNodes;
+            for(auto* helper : engine_->helper_threads_)
+                search_info_->AllThreadsVisitedNodes += helper->GetSearchInfo()->TotalVisitedNodes;
+            engine_->IterationCompletedDelegate.Execute(depth, best_score);
+        }
+
+#ifdef DEBUG
+        const auto pvmoves = engine_->hash_table_->GetLine(board_, move_generator_, depth);
+        LOGI("depth %d, score %d, move: %s, nodes %ld",
+			depth, best_score, *search_info_->BestMove.ToString(), 
+			search_info_->TotalVisitedNodes);
+
+        FString str = "pv";
+        for(auto& move : pvmoves) {
+            str += " " + move.ToString();
+        }
+
+        LOGI("%s", *str);
+        LOGI("Ordering %.2f", search_info_->F_H == 0 ? 0 :
+            search_info_->F_H_F / search_info_->F_H);
+#endif
+    }
+}
+
+int32 UMoveExplorer::Evaluate() const
+{
+    auto score = 0;
+    if(eval_table_->Probe(board_->pos_key_, score)) {
+        search_info_->EvalCacheHits++;
+        return score;
+    }
+
+    search_info_->EvalCacheMisses++;
+    score = EvaluatePosition();
+    eval_table_->Store(board_->pos_key_, score);
+    return score;
+}
+
+int32 UMoveExplorer::EvaluatePosition() const
+{
+    auto* board = board_;
+    // the phase goes from TOTAL_PHASE with every piece on the board down to 0
+    // as pieces come off, and blends the middlegame and endgame sums in between
+    const auto minors = board->n_minor_pieces_[ESide::white] + board->n_minor_pieces_[ESide::black];
+    const auto majors = board->n_major_pieces_[ESide::white] + board->n_major_pieces_[ESide::black] - 2; // kings
+    const auto phase = FMath::Min(int32(minors * MINOR_PHASE + majors * MAJOR_PHASE), TOTAL_PHASE);
+
+    search_info_->PawnHashProbes++;
+    auto& pawns = pawn_table_->GetEntry(board->pawn_key_);
+    if(pawns.Key == board->pawn_key_) {
+        search_info_->PawnHashHits++;
+    } else {
+        pawns.Key = board->pawn_key_;
+        EvaluatePawns(pawns.Middlegame, pawns.Endgame);
+    }
+
+    const auto middlegame = board->middlegame_score_ + pawns.Middlegame;
+    const auto endgame = board->endgame_score_ + pawns.Endgame;
+    const auto positional = (middlegame * phase + endgame * (TOTAL_PHASE - phase)) / TOTAL_PHASE;
+
+    const int32 score = board->material_score_[ESide::white] - board->material_score_[ESide::black] + positional;
+
+    return board->side_ == ESide::white ? score : -score;
+}
+
+void UMoveExplorer::EvaluatePawns(int32& middlegame, int32& endgame) const
+{
+    middlegame = 0;
+    endgame = 0;
+
+    for(uint32 side = ESide::white; side <= ESide::black; ++side) {
+        const auto own = board_->pawns_[side].Get();
+        const auto enemy = board_->pawns_[side ^ 1].Get();
+        const auto sign = side == ESide::white ? 1 : -1;
+
+        auto pawns = board_->pawns_[side];
+        while(!pawns.IsEmpty()) {
+            const auto sq64 = pawns.Pop();
+            const auto file = sq64 & 7;
+            const auto relative_rank = side == ESide::white ? sq64 >> 3 : 7 - (sq64 >> 3);
+            const auto stop = side == ESide::white ? sq64 + 8 : sq64 - 8;
+
+            // the rear one of doubled pawns pays, and it cannot be passed
+            const auto is_doubled = (own & passed_masks[side][sq64] & file_masks[file]) != 0;
+            if(is_doubled) {
+                middlegame -= sign * DOUBLED_PAWN_MG;
+                endgame -= sign * DOUBLED_PAWN_EG;
+            } else if((enemy & passed_masks[side][sq64]) == 0) {
+                middlegame += sign * passed_pawn_mg[relative_rank];
+                endgame += sign * passed_pawn_eg[relative_rank];
+            }
+
+            // no pawn can ever defend an isolated one. a backward one has left its
+            // neighbours ahead and cannot advance past an enemy pawn to join them
+            if((own & adjacent_file_masks[file]) == 0) {
+                middlegame -= sign * ISOLATED_PAWN_MG;
+                endgame -= sign * ISOLATED_PAWN_EG;
+            } else if((own & support_masks[side][sq64]) == 0 && (FBitboard::PawnAttacks(side, stop) & enemy) != 0) {
+                middlegame -= sign * BACKWARD_PAWN_MG;
+                endgame -= sign * BACKWARD_PAWN_EG;
+            }
+        }
+    }
+}
+
+int32 UMoveExplorer::AlphaBeta(int32 alpha, int32 beta, uint32 depth, const bool do_null) const
+{
+    auto* board = board_;
+
+    // check extension: forcing lines are searched one ply deeper so that
+    // the horizon does not hide a mate or the way out of one
+    const auto in_check = board->IsInCheck();
+    if(in_check && depth < max_depth - 1)
+        depth++;
+
+    if(depth == 0)
+        return Quiescence(alpha, beta);
+
+    if((search_info_->TotalVisitedNodes & 2047) == 0)
+        CheckTimeIsUp();
+
+    search_info_->TotalVisitedNodes++;
+
+    // the root always has to come back with a move, even in a repeated position
+    if(board->ply_ > 0 && (board->fifty_move_counter_ >= 100 || board->HasRepetition()))
+        return 0; // draw
+
+    if(board->ply_ > max_depth - 1)
+        return Evaluate();
+
+    // mate distance pruning: nothing here can beat a mate already found closer to the root
+    if(board->ply_ > 0) {
+        alpha = FMath::Max(alpha, -mate_score + int32(board->ply_));
+        beta = FMath::Min(beta, mate_score - int32(board->ply_) - 1);
+        if(alpha >= beta)
+            return alpha;
+    }
+
+    auto hash_score = -infinite_score;
+    auto pv_move = FMove::no_move;
+    if(engine_->hash_table_->Probe(board->pos_key_, depth, alpha, beta, board->ply_, hash_score, pv_move)
+        && board->ply_ > 0)
+        return hash_score;
+
+    const auto is_pv = beta - alpha > 1;
+    const auto side = board->side_;
+    const auto& params = engine_->SearchParams;
+    const auto static_eval = in_check ? -infinite_score : Evaluate();
+
+    // reverse futility pruning: static eval is so far above beta that
+    // a shallow search is not expected to bring it back down
+    if(params.UseReverseFutilityPruning && !is_pv && !in_check && depth <= REVERSE_FUTILITY_MAX_DEPTH
+        && FMath::Abs(beta) < IS_MATE && static_eval - REVERSE_FUTILITY_MARGIN * int32(depth) >= beta)
+        return beta;
+
+    // razoring: static eval is so far below alpha that only captures could save
+    // the position, so let quiescence decide whether it is worth searching
+    if(params.UseRazoring && !is_pv && !in_check && depth <= RAZORING_MAX_DEPTH
+        && FMath::Abs(alpha) < IS_MATE && static_eval + RAZORING_MARGIN * int32(depth) <= alpha) {
+        const auto score = Quiescence(alpha, alpha + 1);
+        if(search_info_->bStopRequested)
+            return 0;
+
+        if(score <= alpha)
+            return alpha;
+    }
+
+    // null move pruning: if passing still fails high, a real move would too. not in pv
+    // nodes, not in check, not twice in a row and not without pieces, where zugzwang is likely.
+    // the null move is made last, a full undo stack skips the pruning
+    if(do_null && !is_pv && params.UseNullCut && board->ply_ > 0 && depth >= NULL_MOVE_MIN_DEPTH
+        && board->n_big_pieces_[side] > 1 && !in_check && static_eval >= beta
+        && board->MakeNullMove()) {
+        const auto reduction = depth > 6 ? 3u : 2u;
+        const auto null_depth = depth > reduction ? depth - 1 - reduction : 0u;
+
+        const auto score = -AlphaBeta(-beta, -beta + 1, null_depth, false);
+        board->TakeNullMove();
+
+        if(search_info_->bStopRequested)
+            return 0;
+
+        if(score >= beta)
+            return beta;
+    }
+
+    // futility pruning: quiet moves cannot lift a hopeless static eval above alpha
+    const auto futile = params.UseFutilityPruning && !is_pv && !in_check && depth <= FUTILITY_MAX_DEPTH
+        && FMath::Abs(alpha) < IS_MATE && static_eval + futility_margins[depth] <= alpha;
+    const auto can_reduce = params.UseLateMoveReductions && !in_check && depth >= LMR_MIN_DEPTH;
+
+    uint32 legal = 0;
+    const auto old_alpha = alpha;
+    auto best_move = FMove::no_move;
+    auto best_score = -infinite_score;
+
+    // pv move first, then captures, killers and quiets as they are needed
+    FMovePicker picker(board, move_generator_, search_info_, pv_move, board->ply_);
+    FMove move;
+    while(picker.Next(move)) {
+        if(!board->MakeMove(move))
+            continue;
+
+        legal++;
+        const auto is_quiet = !UMoveGenerator::IsNoisy(move);
+        if(futile && legal > 1 && is_quiet && !board->IsInCheck()) {
+            board->TakeMove();
+            continue;
+        }
+
+        // principal variation search: the first move is expected to be best, so the
+        // rest only have to be proven worse with a null window unless they beat alpha
+        int32 score;
+        if(legal == 1) {
+            score = -AlphaBeta(-beta, -alpha, depth - 1, true);
+        } else {
+            // late quiet moves are searched shallower, one ply less
+            // for those that raised alpha somewhere before
+            auto reduction = 0u;
+            if(can_reduce && legal > LMR_MIN_MOVES && is_quiet
+                && move != search_info_->GetKiller(0, board->ply_ - 1)
+                && move != search_info_->GetKiller(1, board->ply_ - 1)
+                && !board->IsInCheck()) {
+                reduction = lmr_reductions[FMath::Min(depth, uint32(max_depth - 1))][FMath::Min(legal, uint32(max_position_moves - 1))];
+                if(reduction > 0 && search_info_->GetHistory(board->b_[move.To()], move.To()) > 0)
+                    reduction--;
+                reduction = FMath::Min(reduction, depth - 2);
+            }
+
+            score = -AlphaBeta(-alpha - 1, -alpha, depth - 1 - reduction, true);
+            if(reduction > 0 && score > alpha)
+                score = -AlphaBeta(-alpha - 1, -alpha, depth - 1, true);
+            if(score > alpha && score < beta) {
+                search_info_->NullWindowResearches++;
+                score = -AlphaBeta(-beta, -alpha, depth - 1, true);
+            }
+        }
+        board->TakeMove();
+
+        if(search_info_->bStopRequested)
+            return 0;
+
+        if(score > best_score) {
+            best_score = score;
+            best_move = move;
+        }
+
+        if(score > alpha) {
+            // kept per thread, the root entry of the shared table may hold another thread's move
+            if(board->ply_ == 0)
+                search_info_->RootBestMove = move;
+
+            if(score >= beta) {
+#ifdef DEBUG
+                if(legal == 1)
+                    search_info_->F_H_F++;
+                search_info_->F_H++;
+#endif
+
+                if(!move.IsCaptured())
+                    search_info_->AddKiller(board->ply_, move);
+
+                engine_->hash_table_->Store(board->pos_key_, best_move, beta, depth, EHashFlag::beta, board->ply_);
+                return beta;
+            }
+            alpha = score;
+
+            if(!move.IsCaptured())
+                search_info_->AddHistory(board->b_[best_move.From()], best_move.To(), depth);
+        }
+    }
+
+    if(legal == 0) {
+        if(in_check)
+            return -mate_score + board->ply_; // mate
+        return 0; // stalemate and draw
+    }
+
+    if(alpha != old_alpha)
+        engine_->hash_table_->Store(board->pos_key_, best_move, alpha, depth, EHashFlag::exact, board->ply_);
+    else
+        engine_->hash_table_->Store(board->pos_key_, best_move, alpha, depth, EHashFlag::alpha, board->ply_);
+
+    return alpha;
+}
+
+int32 UMoveExplorer::Quiescence(int32 alpha, const int32 beta) const
+{
+    auto* board = board_;
+    MAKE_SURE(board->IsOk());
+
+    if((search_info_->TotalVisitedNodes & 2047) == 0)
+        CheckTimeIsUp();
+
+    search_info_->TotalVisitedNodes++;
+
+    if(board->fifty_move_counter_ >= 100 || board->HasRepetition())
+        return 0; // draw
+
+    if(board->ply_ > max_depth - 1)
+        return Evaluate();
+
+    // standing pat is not an option in check, every evasion is searched instead
+    const auto in_check = board->IsInCheck();
+    if(!in_check) {
+        const auto stand_pat = Evaluate();
+        if(stand_pat >= beta)
+            return beta;
+
+        if(stand_pat > alpha)
+            alpha = stand_pat;
+    }
+
+    uint32 legal = 0;
+    FMovePicker picker(board, move_generator_, in_check);
+    FMove move;
+    while(picker.Next(move)) {
+        if(!board->MakeMove(move))
+            continue;
+
+        legal++;
+        const auto score = -Quiescence(-beta, -alpha);
+        board->TakeMove();
+
+        if(search_info_->bStopRequested)
+            return 0;
+
+        if(score > alpha) {
+            if(score >= beta) {
+#ifdef DEBUG
+                if(legal == 1)
+                    search_info_->F_H_F++;
+                search_info_->F_H++;
+#endif
+
+                return beta;
+            }
+            alpha = score;
+        }
+    }
+
+    if(in_check && legal == 0)
+        return -mate_score + board->ply_; // mate
+
+    return alpha;
+}
+
+void UMoveExplorer::CheckTimeIsUp() const
+{
+    // no stop time means the search only ends by depth or by a stop request
+    const auto ponder_stop_time = search_info_->PonderStopTimeMs.GetValue() / 1000.0;
+    const auto stop_time = ponder_stop_time > 0 ? ponder_stop_time : search_info_->StopTimeSet;
+    if(stop_time > 0 && FPlatformTime::Seconds() >= stop_time)
+        search_info_->bStopRequested = true;
+}
+
+FMoveExplorerThread::FMoveExplorerThread(UChessEngine* engine)
+    : engine_(engine)
+{
+    LOGI("thread starting");
+    event_ = FGenericPlatformProcess::GetSynchEventFromPool(false);
+    check(event_);
+    thread_ = FRunnableThread::Create(this, TEXT("SearchThread"));
+    check(thread_);
+}
+
+FMoveExplorerThread::~FMoveExplorerThread()
+{
+    if(event_) {
+        FGenericPlatformProcess::ReturnSynchEventToPool(event_);
+        event_ = nullptr;
+    }
+
+    delete thread_;
+}
+
+uint32 FMoveExplorerThread::Run()
+{
+    // initial wait so that engine does not go wild
+    // and start searching before game start
+    event_->Wait();
+
+    while(!is_killing_) {
+        if(!is_stopping_search_) {
+            FPlatformProcess::Sleep(0.01);
+
+            const auto best_move = engine_->move_explorer_->Search();
+            auto* engine = engine_;
+            AsyncTask(ENamedThreads::GameThread, [engine, best_move]() -> void
+            {
+                // should be bound by the caller until this point
+                engine->MoveFoundDelegate.Execute(best_move);
+            });
+            StopSearch();
+        } else {
+            event_->Wait();
+
+            if(is_killing_)
+                break;
+        }
+    }
+
+    LOGI("thread exiting");
+    return 0;
+}
+
+void FMoveExplorerThread::Stop()
+{
+    DoStop();
+    thread_->WaitForCompletion();
+}
+
+void FMoveExplorerThread::DoStop()
+{
+    is_killing_ = true;
+    StartSearch(); // breaks out of the loop
+}
+
+void FMoveExplorerThread::StartSearch()
+{
+    is_stopping_search_ = false;
+    if(event_)
+        event_->Trigger();
+}
+
+void FMoveExplorerThread::StopSearch()
+{
+    is_stopping_search_ = true;
+}
+
+FMoveExplorerHelperThread::FMoveExplorerHelperThread(UChessEngine* engine, const uint32 index)
+    : index_(index)
+{
+    // nothing the garbage collector sees refers to these, so they stay rooted for the helper's life
+    board_ = NewObject<UBoard>();
+    board_->AddToRoot();
+    move_generator_ = NewObject<UMoveGenerator>();
+    move_generator_->AddToRoot();
+    move_explorer_ = NewObject<UMoveExplorer>();
+    move_explorer_->AddToRoot();
+    search_info_ = new FSearchInfo();
+
+    move_generator_->SetContext(engine, board_, search_info_);
+    move_explorer_->SetContext(engine, board_, move_generator_, search_info_);
+
+    start_event_ = FGenericPlatformProcess::GetSynchEventFromPool(false);
+    done_event_ = FGenericPlatformProcess::GetSynchEventFromPool(false);
+    check(start_event_ && done_event_);
+    thread_ = FRunnableThread::Create(this, *FString::Printf(TEXT("SearchHelperThread%d"), index));
+    check(thread_);
+}
+
+FMoveExplorerHelperThread::~FMoveExplorerHelperThread()
+{
+    FGenericPlatformProcess::ReturnSynchEventToPool(start_event_);
+    FGenericPlatformProcess::ReturnSynchEventToPool(done_event_);
+
+    delete thread_;
+    delete search_info_;
+
+    move_explorer_->RemoveFromRoot();
+    move_generator_->RemoveFromRoot();
+    board_->RemoveFromRoot();
+}
+
+uint32 FMoveExplorerHelperThread::Run()
+{
+    while(true) {
+        start_event_->Wait();
+        if(is_killing_)
+            break;
+
+        move_explorer_->SearchAsHelper(index_);
+        done_event_->Trigger();
+    }
+
+    LOGI("helper %d exiting", index_);
+    return 0;
+}
+
+void FMoveExplorerHelperThread::Stop()
+{
+    is_killing_ = true;
+    start_event_->Trigger();
+    thread_->WaitForCompletion();
+}
+
+void FMoveExplorerHelperThread::StartSearch(const UBoard* board)
+{
+    // prepared on the caller's thread so that a quick
+    // StopSearch cannot be undone by the helper clearing its info
+    board_->CopyFrom(board);
+    move_explorer_->PrepareSearch();
+    start_event_->Trigger();
+}
+
+void FMoveExplorerHelperThread::StopSearch()
+{
+    search_info_->bStopRequested = true;
+    done_event_->Wait();
+}
+
+const FSearchInfo* FMoveExplorerHelperThread::GetSearchInfo() const
+{
+    return search_info_;
+}
@@ -0,0 +1,425 @@
+// Copyright 2018 Emre Simsirli
+
+#include "MoveGenerator.h"
+#include "Verify.h"
+#include "PieceInfo.h"
+#include "Board.h"
+#include "Debug.h"
+#include "Search.h"
+#include "ChessEngine.h"
+#include "Util/Log.h"
+
+#define CAPTURE_SCORE 1000000
+#define FIRST_KILLER_SCORE 900000
+#define SECOND_KILLER_SCORE 800000
+
+using ::EPieceType;
+
+namespace
+{
+    const uint32 victim_score[] = {0, 100, 200, 300, 400, 500, 600, 100, 200, 300, 400, 500, 600};
+    // most valuable victim - least valuable attacker
+    int32 mvv_lva_scores[n_pieces][n_pieces];
+}
+
+void UMoveGenerator::Initialize()
+{
+    for(uint32 attacker = wp; attacker <= bk; attacker++)
+        for(uint32 victim = wp; victim <= bk; victim++)
+            mvv_lva_scores[victim][attacker] = victim_score[victim] + 6 - victim_score[attacker] / 100;
+    
+    LOGI("initialized");
+}
+
+void UMoveGenerator::SetContext(const UChessEngine* engine, UBoard* board, FSearchInfo* search_info)
+{
+    engine_ = engine;
+    board_ = board;
+    search_info_ = search_info;
+}
+
+void UMoveGenerator::GenerateMoves(FMoveList& moves) const
+{
+    moves.Reset();
+    GenerateSideMoves(EMoveGenType::all, moves);
+}
+
+void UMoveGenerator::GenerateMoves(const uint32 sq, FMoveList& moves) const
+{
+    moves.Reset();
+    GeneratePieceMoves(sq, EMoveGenType::all, moves);
+}
+
+void UMoveGenerator::GenerateCaptures(FMoveList& moves) const
+{
+    GenerateSideMoves(EMoveGenType::captures, moves);
+}
+
+void UMoveGenerator::GenerateQuiets(FMoveList& moves) const
+{
+    GenerateSideMoves(EMoveGenType::quiets, moves);
+}
+
+void UMoveGenerator::GenerateLegalMoves(FMoveList& moves) const
+{
+    moves.Reset();
+    GenerateSideMoves(EMoveGenType::all, moves);
+    RemoveIllegalMoves(moves);
+}
+
+void UMoveGenerator::GenerateLegalMoves(const uint32 sq, FMoveList& moves) const
+{
+    GenerateMoves(sq, moves);
+    RemoveIllegalMoves(moves);
+}
+
+bool UMoveGenerator::HasLegalMove() const
+{
+    const auto info = GetCheckInfo();
+
+    FMoveList moves;
+    GenerateSideMoves(EMoveGenType::all, moves);
+    for(const auto& move : moves) {
+        if(IsLegal(move, info))
+            return true;
+    }
+    return false;
+}
+
+bool UMoveGenerator::IsNoisy(const FMove& m)
+{
+    return m.IsCaptured() || m.PromotedPiece() == wq || m.PromotedPiece() == bq;
+}
+
+void UMoveGenerator::GenerateSideMoves(const EMoveGenType::Type type, FMoveList& moves) const
+{
+    uint32 piece_offset = 0;
+    if(board_->side_ == ESide::black)
+        piece_offset = 6;
+
+    for(auto p = wp + piece_offset; p <= wk + piece_offset; ++p)
+        for(auto sq : board_->piece_locations_[p])
+            GeneratePieceMoves(sq, type, moves);
+}
+
+void UMoveGenerator::GeneratePieceMoves(const uint32 sq, const EMoveGenType::Type type, FMoveList& moves) const
+{
+    const auto& piece_info = piece_infos[board_->b_[sq]];
+
+    if(piece_info.bIsPawn) {
+        GeneratePawnMoves(sq, type, moves);
+    } else if(piece_info.bIsSliding) {
+        GenerateSlidingMoves(sq, type, moves);
+    } else {
+        GenerateNonSlidingMoves(sq, type, moves);
+        if(piece_info.bIsKing && type != EMoveGenType::captures)
+            GenerateCastlingMoves(moves);
+    }
+}
+
+bool UMoveGenerator::DoesMoveExist(const FMove& m) const
+{
+    return IsPseudoLegal(m) && IsLegal(m);
+}
+
+bool UMoveGenerator::IsLegal(const FMove& m) const
+{
+    return IsLegal(m, GetCheckInfo());
+}
+
+FCheckInfo UMoveGenerator::GetCheckInfo() const
+{
+    const auto side = board_->side_;
+    const auto offset = side == ESide::white ? 6 : 0; // opponent pieces
+    const auto occupancy = board_->occupancy_[ESide::both].Get();
+
+    FCheckInfo info;
+    info.KingSq = ESquare::Sq64(board_->king_sq_[side]);
+    info.Checkers = board_->AttackersTo(info.KingSq, side ^ 1, occupancy);
+    info.Pinned = 0;
+    info.Evasions = ~0ULL;
+
+    if(info.Checkers) {
+        auto checkers = FBitboard(info.Checkers);
+        info.Evasions = FBitboard::Between(info.KingSq, checkers.Pop()) | info.Checkers;
+    }
+
+    // an own piece alone between the king and a slider that would otherwise hit it is pinned
+    const auto queens = board_->pieces_[wq + offset].Get();
+    auto snipers = FBitboard(
+        (FBitboard::BishopAttacks(info.KingSq, 0) & (board_->pieces_[wb + offset].Get() | queens))
+        | (FBitboard::RookAttacks(info.KingSq, 0) & (board_->pieces_[wr + offset].Get() | queens)));
+
+    while(!snipers.IsEmpty()) {
+        const auto blockers = FBitboard::Between(info.KingSq, snipers.Pop()) & occupancy;
+        if(blockers && (blockers & (blockers - 1)) == 0 && (blockers & board_->occupancy_[side].Get()))
+            info.Pinned |= blockers;
+    }
+
+    return info;
+}
+
+bool UMoveGenerator::IsLegal(const FMove& m, const FCheckInfo& info) const
+{
+    const auto side = board_->side_;
+    const auto from = ESquare::Sq64(m.From());
+    const auto to = ESquare::Sq64(m.To());
+    const auto occupancy = board_->occupancy_[ESide::both].Get();
+
+    // the king's target must be safe once it has left its square. castling
+    // has checked the squares it starts on and passes already
+    if(piece_infos[board_->b_[m.From()]].bIsKing)
+        return board_->AttackersTo(to, side ^ 1, occupancy ^ 1ULL << from) == 0;
+
+    // two pawns leave the same rank or diagonal at once, so look at the result
+    if(m.IsEnPassant()) {
+        const auto captured = side == ESide::white ? to - 8 : to + 8;
+        const auto after = occupancy ^ 1ULL << from ^ 1ULL << to ^ 1ULL << captured;
+        return (board_->AttackersTo(info.KingSq, side ^ 1, after) & ~(1ULL << captured)) == 0;
+    }
+
+    // only the king can get out of a double check
+    if(info.Checkers & (info.Checkers - 1))
+        return false;
+
+    if(!(info.Evasions & 1ULL << to))
+        return false;
+
+    return !(info.Pinned & 1ULL << from) || (FBitboard::Line(info.KingSq, from) & 1ULL << to);
+}
+
+void UMoveGenerator::RemoveIllegalMoves(FMoveList& moves) const
+{
+    const auto info = GetCheckInfo();
+
+    auto n_legal = 0;
+    for(const auto& move : moves) {
+        if(IsLegal(move, info))
+            moves[n_legal++] = move;
+    }
+    moves.Count = n_legal;
+}
+
+bool UMoveGenerator::IsPseudoLegal(const FMove& m) const
+{
+    // hash and killer moves may come from a different position
+    if(!Verification::IsSquareOnBoard(m.From()) || piece_infos[board_->b_[m.From()]].Side != board_->side_)
+        return false;
+
+    FMoveList moves;
+    GenerateMoves(m.From(), moves);
+    return moves.Find(m) != nullptr;
+}
+
+void UMoveGenerator::GeneratePawnMoves(const uint32 sq, const EMoveGenType::Type type, FMoveList& moves) const
+{
+    MAKE_SURE(Verification::IsSquareOnBoard(sq));
+
+    const auto board = board_->b_;
+    const auto d = board_->side_ == ESide::white ? 1 : -1; // direction
+    const auto other_side = board_->side_ ^ 1;
+
+    if(board[sq + 10 * d] == empty) {
+        AddPawnRegularMove(sq, sq + 10 * d, type, moves);
+        if(type != EMoveGenType::captures) {
+            if(d == 1 && ESquare::Rank(sq) == ERank::rank_2 && board[sq + 20] == empty)
+                AddQuietMove(FMove::Create(sq, sq + 20, empty, empty, FMove::flag_pawn_start), moves);
+            else if(d == -1 && ESquare::Rank(sq) == ERank::rank_7 && board[sq - 20] == empty)
+                AddQuietMove(FMove::Create(sq, sq - 20, empty, empty, FMove::flag_pawn_start), moves);
+        }
+    }
+
+    if(type == EMoveGenType::quiets)
+        return;
+
+    if(Verification::IsSquareOnBoard(sq + 9 * d) && piece_infos[board[sq + 9 * d]].Side == other_side)
+        AddPawnCaptureMove(sq, sq + 9 * d, board[sq + 9 * d], moves);
+    if(Verification::IsSquareOnBoard(sq + 11 * d) && piece_infos[board[sq + 11 * d]].Side == other_side)
+        AddPawnCaptureMove(sq, sq + 11 * d, board[sq + 11 * d], moves);
+
+    const auto en_passant_sq = board_->en_passant_sq_;
+    if(en_passant_sq != ESquare::no_sq) {
+        if(sq + 9 * d == en_passant_sq)
+            AddEnPassantMove(FMove::Create(sq, sq + 9 * d, empty, empty, FMove::flag_en_passant), moves);
+        else if(sq + 11 * d == en_passant_sq)
+            AddEnPassantMove(FMove::Create(sq, sq + 11 * d, empty, empty, FMove::flag_en_passant), moves);
+    }
+}
+
+void UMoveGenerator::GenerateSlidingMoves(const uint32 sq, const EMoveGenType::Type type, FMoveList& moves) const
+{
+    const auto& piece_info = piece_infos[board_->b_[sq]];
+    const auto sq64 = ESquare::Sq64(sq);
+    const auto occupancy = board_->occupancy_[ESide::both].Get();
+
+    uint64 attacks = 0;
+    if(piece_info.bIsBishopOrQueen)
+        attacks |= FBitboard::BishopAttacks(sq64, occupancy);
+    if(piece_info.bIsRookOrQueen)
+        attacks |= FBitboard::RookAttacks(sq64, occupancy);
+
+    AddAttackMoves(sq, attacks, type, moves);
+}
+
+void UMoveGenerator::GenerateNonSlidingMoves(const uint32 sq, const EMoveGenType::Type type, FMoveList& moves) const
+{
+    const auto sq64 = ESquare::Sq64(sq);
+    const auto attacks = piece_infos[board_->b_[sq]].bIsKnight
+                             ? FBitboard::KnightAttacks(sq64)
+                             : FBitboard::KingAttacks(sq64);
+
+    AddAttackMoves(sq, attacks, type, moves);
+}
+
+void UMoveGenerator::AddAttackMoves(const uint32 sq, const uint64 attacks,
+                                    const EMoveGenType::Type type, FMoveList& moves) const
+{
+    const auto board = board_->b_;
+    const auto side = board_->side_;
+
+    if(type != EMoveGenType::quiets) {
+        auto captures = FBitboard(attacks & board_->occupancy_[side ^ 1].Get());
+        while(!captures.IsEmpty()) {
+            const auto to = ESquare::Sq120(captures.Pop());
+            AddCaptureMove(FMove::Create(sq, to, board[to], empty, 0), moves);
+        }
+    }
+
+    if(type == EMoveGenType::captures)
+        return;
+
+    auto quiets = FBitboard(attacks & ~board_->occupancy_[ESide::both].Get());
+    while(!quiets.IsEmpty())
+        AddQuietMove(FMove::Create(sq, ESquare::Sq120(quiets.Pop()), empty, empty, 0), moves);
+}
+
+void UMoveGenerator::GenerateCastlingMoves(FMoveList& moves) const
+{
+    const auto board = board_->b_;
+    const auto cast_perm = board_->cast_perm_;
+
+    if(board_->side_ == ESide::white) {
+        if(cast_perm & ECastlingPermission::c_wk) {
+            if(board[ESquare::f1] == empty && board[ESquare::g1] == empty) {
+                if(!board_->IsAttacked(ESquare::e1, ESide::black)
+                    && !board_->IsAttacked(ESquare::f1, ESide::black)) {
+                    AddQuietMove(FMove::Create(ESquare::e1, ESquare::g1, empty, empty,
+                                               FMove::flag_castling), moves);
+                }
+            }
+        }
+
+        if(cast_perm & ECastlingPermission::c_wq) {
+            if(board[ESquare::d1] == empty
+                && board[ESquare::c1] == empty
+                && board[ESquare::b1] == empty) {
+                if(!board_->IsAttacked(ESquare::e1, ESide::black)
+                    && !board_->IsAttacked(ESquare::d1, ESide::black)) {
+                    AddQuietMove(FMove::Create(ESquare::e1, ESquare::c1, empty, empty,
+                                               FMove::flag_castling), moves);
+                }
+            }
+        }
+    } else {
+        if(cast_perm & ECastlingPermission::c_bk) {
+            if(board[ESquare::f8] == empty
+                && board[ESquare::g8] == empty) {
+                if(!board_->IsAttacked(ESquare::e8, ESide::white)
+                    && !board_->IsAttacked(ESquare::f8, ESide::white)) {
+                    AddQuietMove(FMove::Create(ESquare::e8, ESquare::g8, empty, empty,
+                                               FMove::flag_castling), moves);
+                }
+            }
+        }
+
+        if(cast_perm & ECastlingPermission::c_bq) {
+            if(board[ESquare::d8] == empty
+                && board[ESquare::c8] == empty
+                && board[ESquare::b8] == empty) {
+                if(!board_->IsAttacked(ESquare::e8, ESide::white)
+                    && !board_->IsAttacked(ESquare::d8, ESide::white)) {
+                    AddQuietMove(FMove::Create(ESquare::e8, ESquare::c8, empty, empty,
+                                               FMove::flag_castling), moves);
+                }
+            }
+        }
+    }
+}
+
+void UMoveGenerator::AddQuietMove(FMove move, FMoveList& moves) const
+{
+    if(engine_->bIsMultiplayer) {
+        if(search_info_->GetKiller(0, board_->ply_) == move) {
+            move.SetScore(FIRST_KILLER_SCORE);
+        } else if(search_info_->GetKiller(1, board_->ply_) == move) {
+            move.SetScore(SECOND_KILLER_SCORE);
+        } else {
+            const auto score = search_info_->GetHistory(board_->b_[move.From()], move.To());
+            move.SetScore(score);
+        }
+    }
+    moves.Add(move);
+}
+
+void UMoveGenerator::AddCaptureMove(FMove move, FMoveList& moves) const
+{
+    if(engine_->bIsMultiplayer)
+        move.SetScore(mvv_lva_scores[move.CapturedPiece()][board_->b_[move.From()]] + CAPTURE_SCORE);
+    moves.Add(move);
+}
+
+void UMoveGenerator::AddPromotionMove(FMove move, FMoveList& moves) const
+{
+    // ordered along with the captures, by the value of the new piece
+    if(engine_->bIsMultiplayer)
+        move.SetScore(victim_score[move.PromotedPiece()] + CAPTURE_SCORE);
+    moves.Add(move);
+}
+
+void UMoveGenerator::AddEnPassantMove(FMove move, FMoveList& moves) const
+{
+    if(engine_->bIsMultiplayer)
+        move.SetScore(105 + CAPTURE_SCORE); // pawn takes pawn 
+    moves.Add(move);
+}
+
+void UMoveGenerator::AddPawnRegularMove(const uint32 from, const uint32 to,
+                                        const EMoveGenType::Type type, FMoveList& moves) const
+{
+    MAKE_SURE(Verification::IsSquareOnBoard(from));
+    MAKE_SURE(Verification::IsSquareOnBoard(to));
+
+    const auto white = board_->side_ == ESide::white;
+    const auto promotion_rank = white ? ERank::rank_7 : ERank::rank_2;
+    if(ESquare::Rank(from) != promotion_rank) {
+        if(type != EMoveGenType::captures)
+            AddQuietMove(FMove::Create(from, to, empty, empty, 0), moves);
+        return;
+    }
+
+    if(type != EMoveGenType::quiets)
+        AddPromotionMove(FMove::Create(from, to, empty, white ? wq : bq, 0), moves);
+
+    if(type != EMoveGenType::captures) {
+        for(uint32 promoted : {wr, wb, wn})
+            AddQuietMove(FMove::Create(from, to, empty, white ? promoted : promoted + 6, 0), moves);
+    }
+}
+
+void UMoveGenerator::AddPawnCaptureMove(const uint32 from, const uint32 to,
+                                        const uint32 captured, FMoveList& moves) const
+{
+    MAKE_SURE(Verification::IsPieceValidOrEmpty(captured));
+    MAKE_SURE(Verification::IsSquareOnBoard(from));
+    MAKE_SURE(Verification::IsSquareOnBoard(to));
+
+    if(board_->side_ == ESide::white && ESquare::Rank(from) == ERank::rank_7) {
+        for(uint32 promoted : {wq, wr, wb, wn})
+            AddCaptureMove(FMove::Create(from, to, captured, promoted, 0), moves);
+    } else if(board_->side_ == ESide::black && ESquare::Rank(from) == ERank::rank_2) {
+        for(uint32 promoted : {bq, br, bb, bn})
+            AddCaptureMove(FMove::Create(from, to, captured, promoted, 0), moves);
+    } else {
+        AddCaptureMove(FMove::Create(from, to, captured, empty, 0), moves);
+    }
+}
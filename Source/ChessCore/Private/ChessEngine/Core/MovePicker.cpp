@@ -0,0 +1,171 @@
+// Copyright 2018 Emre Simsirli
+
+#include "MovePicker.h"
+#include "Board.h"
+#include "MoveGenerator.h"
+#include "PieceInfo.h"
+#include "Search.h"
+
+FMovePicker::FMovePicker(const UBoard* board, const UMoveGenerator* move_generator,
+                         const FSearchInfo* search_info, const FMove& hash_move, const uint32 ply)
+    : board_(board), move_generator_(move_generator), search_info_(search_info),
+      hash_move_(hash_move), ply_(ply), captures_only_(false), stage_(EPickerStage::hash_move),
+      index_(0), capture_end_(0), bad_capture_end_(0), killer_index_(0)
+{
+    killers_[0] = search_info_->GetKiller(0, ply_);
+    killers_[1] = search_info_->GetKiller(1, ply_);
+}
+
+FMovePicker::FMovePicker(const UBoard* board, const UMoveGenerator* move_generator, const bool in_check)
+    : board_(board), move_generator_(move_generator), search_info_(nullptr),
+      hash_move_(FMove::no_move), ply_(0), captures_only_(true),
+      stage_(in_check ? EPickerStage::generate_evasions : EPickerStage::generate_captures),
+      index_(0), capture_end_(0), bad_capture_end_(0), killer_index_(0)
+{
+    killers_[0] = FMove::no_move;
+    killers_[1] = FMove::no_move;
+}
+
+bool FMovePicker::Next(FMove& move)
+{
+    switch(stage_) {
+        case EPickerStage::generate_evasions:
+            move_generator_->GenerateLegalMoves(moves_);
+            index_ = 0;
+            stage_ = EPickerStage::evasions;
+            // fall through
+
+        case EPickerStage::evasions:
+            if(index_ < moves_.Num()) {
+                PickBest(index_, moves_.Num());
+                move = moves_[index_++];
+                return true;
+            }
+
+            stage_ = EPickerStage::done;
+            return false;
+
+        case EPickerStage::hash_move:
+            stage_ = EPickerStage::generate_captures;
+            if(hash_move_ != FMove::no_move && move_generator_->IsPseudoLegal(hash_move_)) {
+                move = hash_move_;
+                return true;
+            }
+            // fall through
+
+        case EPickerStage::generate_captures:
+            move_generator_->GenerateCaptures(moves_);
+            capture_end_ = moves_.Num();
+            index_ = 0;
+            stage_ = EPickerStage::good_captures;
+            // fall through
+
+        case EPickerStage::good_captures:
+            while(index_ < capture_end_) {
+                PickBest(index_, capture_end_);
+                const auto capture = moves_[index_++];
+                if(capture == hash_move_)
+                    continue;
+
+                // slots before index_ are consumed, so losing captures can be parked
+                // there. quiescence does not search them at all
+                if(IsLosingCapture(capture)) {
+                    if(!captures_only_)
+                        moves_[bad_capture_end_++] = capture;
+                    continue;
+                }
+
+                move = capture;
+                return true;
+            }
+
+            if(captures_only_) {
+                stage_ = EPickerStage::done;
+                return false;
+            }
+
+            stage_ = EPickerStage::killers;
+            // fall through
+
+        case EPickerStage::killers:
+            while(killer_index_ < 2) {
+                const auto& killer = killers_[killer_index_++];
+                if(killer != FMove::no_move && killer != hash_move_
+                    && !UMoveGenerator::IsNoisy(killer) && move_generator_->IsPseudoLegal(killer)) {
+                    move = killer;
+                    return true;
+                }
+            }
+
+            stage_ = EPickerStage::generate_quiets;
+            // fall through
+
+        case EPickerStage::generate_quiets:
+            // every capture is consumed by now, quiets go after them
+            move_generator_->GenerateQuiets(moves_);
+            index_ = capture_end_;
+            stage_ = EPickerStage::quiets;
+            // fall through
+
+        case EPickerStage::quiets:
+            while(index_ < moves_.Num()) {
+                PickBest(index_, moves_.Num());
+                const auto quiet = moves_[index_++];
+                if(quiet == hash_move_ || IsKiller(quiet))
+                    continue;
+
+                move = quiet;
+                return true;
+            }
+
+            index_ = 0;
+            stage_ = EPickerStage::bad_captures;
+            // fall through
+
+        case EPickerStage::bad_captures:
+            // already in mvv-lva order since they were parked while picking
+            if(index_ < bad_capture_end_) {
+                move = moves_[index_++];
+                return true;
+            }
+
+            stage_ = EPickerStage::done;
+            // fall through
+
+        default:
+            return false;
+    }
+}
+
+void FMovePicker::PickBest(const int32 begin, const int32 end)
+{
+    auto best = begin;
+    for(auto i = begin + 1; i < end; ++i) {
+        if(moves_[i].GetScore() > moves_[best].GetScore())
+            best = i;
+    }
+
+    if(best != begin) {
+        const auto tmp = moves_[begin];
+        moves_[begin] = moves_[best];
+        moves_[best] = tmp;
+    }
+}
+
+bool FMovePicker::IsLosingCapture(const FMove& move) const
+{
+    if(!move.IsCaptured() || move.IsEnPassant())
+        return false;
+
+    // taking something at least as valuable cannot lose, whatever the recaptures
+    const auto attacker = board_->b_[move.From()];
+    if(piece_infos[move.CapturedPiece()].Value >= piece_infos[attacker].Value)
+        return false;
+
+    return board_->See(move) < 0;
+}
+
+bool FMovePicker::IsKiller(const FMove& move) const
+{
+    return move == killers_[0] || move == killers_[1];
+}
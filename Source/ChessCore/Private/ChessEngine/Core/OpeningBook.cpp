@@ -0,0 +1,180 @@
+// Copyright 2018 Emre Simsirli
+
+#include "OpeningBook.h"
+#include "Board.h"
+#include "MoveGenerator.h"
+#include "MoveList.h"
+#include "Consts.h"
+#include "Square.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/FileHelper.h"
+#include "Math/UnrealMathUtility.h"
+#include "Util/Log.h"
+
+#define BOOK_ENTRY_SIZE 16
+// offsets in an entry
+#define BOOK_MOVE 8
+#define BOOK_WEIGHT 10
+
+namespace
+{
+    // knight 1 bishop 2 rook 3 queen 4, the same for both sides
+    const uint32 promotion_codes[n_pieces] = {0, 0, 1, 2, 3, 4, 0, 0, 1, 2, 3, 4, 0};
+
+    uint64 ReadBigEndian(const uint8* bytes, const int32 n_bytes)
+    {
+        uint64 value = 0;
+        for(auto i = 0; i < n_bytes; ++i)
+            value = value << 8 | bytes[i];
+        return value;
+    }
+
+    // to file, to rank, from file, from rank and promotion, 3 bits each.
+    // castling is written as the king taking its own rook
+    uint32 ToBookMove(const FMove& move)
+    {
+        const auto from = move.From();
+        auto to = move.To();
+        if(move.IsCastling())
+            to = ESquare::Sq120(ESquare::File(to) == EFile::file_g ? EFile::file_h : EFile::file_a, ESquare::Rank(to));
+
+        return ESquare::File(to)
+            | ESquare::Rank(to) << 3
+            | ESquare::File(from) << 6
+            | ESquare::Rank(from) << 9
+            | promotion_codes[move.PromotedPiece()] << 12;
+    }
+}
+
+FOpeningBook::FOpeningBook()
+    : mapped_file_(nullptr), mapped_region_(nullptr), entries_(nullptr), n_entries_(0)
+{
+}
+
+FOpeningBook::~FOpeningBook()
+{
+    Close();
+}
+
+bool FOpeningBook::Open(const FString& path)
+{
+    Close();
+    path_ = path;
+    if(path.IsEmpty())
+        return false;
+
+#ifdef DEBUG
+    // the key polyglot publishes for the start position
+    MAKE_SURE(NewObject<UBoard>()->GeneratePolyglotKey() == 0x463B96181691FC9CULL);
+#endif
+
+    int64 size = 0;
+    mapped_file_ = FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*path);
+    if(mapped_file_ != nullptr) {
+        mapped_region_ = mapped_file_->MapRegion();
+        if(mapped_region_ != nullptr) {
+            entries_ = mapped_region_->GetMappedPtr();
+            size = mapped_region_->GetMappedSize();
+        }
+    }
+
+    if(entries_ == nullptr) {
+        // not every platform maps files
+        delete mapped_file_;
+        mapped_file_ = nullptr;
+        if(!FFileHelper::LoadFileToArray(loaded_, *path)) {
+            LOGI("could not open opening book %s", *path);
+            return false;
+        }
+        entries_ = loaded_.GetData();
+        size = loaded_.Num();
+    }
+
+    n_entries_ = size / BOOK_ENTRY_SIZE;
+    LOGI("opened opening book %s, %lld entries, %s", *path, n_entries_,
+        mapped_region_ != nullptr ? TEXT("mapped") : TEXT("loaded"));
+    return true;
+}
+
+void FOpeningBook::Close()
+{
+    delete mapped_region_;
+    mapped_region_ = nullptr;
+    delete mapped_file_;
+    mapped_file_ = nullptr;
+    loaded_.Empty();
+    entries_ = nullptr;
+    n_entries_ = 0;
+    path_.Empty();
+}
+
+const FString& FOpeningBook::GetPath() const
+{
+    return path_;
+}
+
+bool FOpeningBook::Probe(const UBoard* board, const UMoveGenerator* move_generator, FMove& move) const
+{
+    if(n_entries_ == 0)
+        return false;
+
+    // first entry of the position
+    const auto key = board->GeneratePolyglotKey();
+    int64 low = 0;
+    auto high = n_entries_;
+    while(low < high) {
+        const auto mid = low + (high - low) / 2;
+        if(GetKey(mid) < key)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    if(low == n_entries_ || GetKey(low) != key)
+        return false;
+
+    FMoveList legal_moves;
+    move_generator->GenerateLegalMoves(legal_moves);
+
+    // a book made for another engine may hold moves this
+    // position does not allow, those are simply skipped
+    FMoveList book_moves;
+    auto total_weight = 0;
+    for(auto i = low; i < n_entries_ && GetKey(i) == key; ++i) {
+        const auto* entry = entries_ + i * BOOK_ENTRY_SIZE;
+        const auto book_move = uint32(ReadBigEndian(entry + BOOK_MOVE, 2));
+        const auto weight = int32(ReadBigEndian(entry + BOOK_WEIGHT, 2));
+        if(weight == 0)
+            continue;
+
+        for(auto m : legal_moves) {
+            if(ToBookMove(m) == book_move) {
+                m.SetScore(weight);
+                book_moves.Add(m);
+                total_weight += weight;
+                break;
+            }
+        }
+    }
+
+    if(total_weight == 0)
+        return false;
+
+    auto pick = FMath::RandRange(0, total_weight - 1);
+    for(const auto& m : book_moves) {
+        pick -= m.GetScore();
+        if(pick < 0) {
+            move = m;
+            break;
+        }
+    }
+
+    LOGI("book move %s out of %d", *move.ToString(), book_moves.Num());
+    return true;
+}
+
+uint64 FOpeningBook::GetKey(const int64 index) const
+{
+    return ReadBigEndian(entries_ + index * BOOK_ENTRY_SIZE, 8);
+}
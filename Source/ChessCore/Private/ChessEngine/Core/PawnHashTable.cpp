@@ -0,0 +1,27 @@
+// Copyright 2018 Emre Simsirli
+
+#include "PawnHashTable.h"
+
+// 16 byte entries, 1 mb in all
+#define PAWN_TABLE_ENTRIES (1 << 16)
+
+FPawnHashTable::FPawnHashTable()
+{
+    entries_.SetNum(PAWN_TABLE_ENTRIES);
+    Clear();
+}
+
+FPawnEntry& FPawnHashTable::GetEntry(const uint64 pawn_key)
+{
+    return entries_[pawn_key & (PAWN_TABLE_ENTRIES - 1)];
+}
+
+void FPawnHashTable::Clear()
+{
+    // a zero key is the position without pawns, which does score zero
+    for(auto& entry : entries_) {
+        entry.Key = 0;
+        entry.Middlegame = 0;
+        entry.Endgame = 0;
+    }
+}
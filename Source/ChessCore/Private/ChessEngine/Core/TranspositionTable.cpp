@@ -0,0 +1,216 @@
+// Copyright 2018 Emre Simsirli
+
+#include "TranspositionTable.h"
+#include "Board.h"
+#include "Consts.h"
+#include "Debug.h"
+#include "HAL/UnrealMemory.h"
+#include "Util/Log.h"
+
+#define IS_MATE (mate_score - max_depth)
+
+namespace
+{
+    // data layout:
+    // 0-24 move, 25-40 score, 41-48 depth, 49-50 flag, 51-56 age
+    const uint64 mask_move = 0x1FFFFFF;
+    const uint64 mask_score = 0xFFFF;
+    const uint64 mask_depth = 0xFF;
+    const uint64 mask_flag = 0x3;
+    const uint64 mask_age = 0x3F;
+
+    const uint32 shift_score = 25;
+    const uint32 shift_depth = 41;
+    const uint32 shift_flag = 49;
+    const uint32 shift_age = 51;
+
+    const int32 score_offset = 0x8000;
+
+    uint64 Pack(const FMove& move, const int32 score, const uint32 depth, const uint32 flag, const uint32 age)
+    {
+        return (move.Raw() & mask_move)
+            | (static_cast<uint64>(score + score_offset) & mask_score) << shift_score
+            | (static_cast<uint64>(depth) & mask_depth) << shift_depth
+            | (static_cast<uint64>(flag) & mask_flag) << shift_flag
+            | (static_cast<uint64>(age) & mask_age) << shift_age;
+    }
+
+    FMove UnpackMove(const uint64 data)
+    {
+        return FMove(static_cast<uint32>(data & mask_move));
+    }
+
+    int32 UnpackScore(const uint64 data)
+    {
+        return static_cast<int32>(data >> shift_score & mask_score) - score_offset;
+    }
+
+    uint32 UnpackDepth(const uint64 data)
+    {
+        return data >> shift_depth & mask_depth;
+    }
+
+    uint32 UnpackFlag(const uint64 data)
+    {
+        return data >> shift_flag & mask_flag;
+    }
+
+    uint32 UnpackAge(const uint64 data)
+    {
+        return data >> shift_age & mask_age;
+    }
+}
+
+UTranspositionTable::~UTranspositionTable()
+{
+    FMemory::Free(buckets_);
+}
+
+void UTranspositionTable::Resize(const uint32 size_mb)
+{
+    if(size_mb == size_mb_ && buckets_)
+        return;
+
+    FMemory::Free(buckets_);
+
+    // round down to a power of two so that indexing is a mask
+    const uint64 max_buckets = static_cast<uint64>(size_mb) * 1024 * 1024 / sizeof(FHashBucket);
+    n_buckets_ = 1;
+    while(n_buckets_ * 2 <= max_buckets)
+        n_buckets_ *= 2;
+
+    buckets_ = static_cast<FHashBucket*>(FMemory::Malloc(n_buckets_ * sizeof(FHashBucket), alignof(FHashBucket)));
+    size_mb_ = size_mb;
+    Clear();
+
+    LOGI("resized to %d mb, %lld buckets", size_mb, n_buckets_);
+}
+
+void UTranspositionTable::NewSearch()
+{
+    age_ = (age_ + 1) & mask_age;
+}
+
+void UTranspositionTable::Clear()
+{
+    FMemory::Memzero(buckets_, n_buckets_ * sizeof(FHashBucket));
+    age_ = 0;
+}
+
+FHashBucket& UTranspositionTable::GetBucket(const uint64 pos_key) const
+{
+    MAKE_SURE(buckets_ != nullptr);
+    return buckets_[pos_key & (n_buckets_ - 1)];
+}
+
+void UTranspositionTable::Store(const uint64 pos_key, const FMove& move, int32 score,
+                                const uint32 depth, const EHashFlag::Type flag, const uint32 ply)
+{
+    MAKE_SURE(depth < max_depth);
+    MAKE_SURE(ply < max_depth);
+
+    // mate scores are stored relative to this node
+    if(score > IS_MATE) score += ply;
+    else if(score < -IS_MATE) score -= ply;
+
+    auto& bucket = GetBucket(pos_key);
+    auto* replace = &bucket.Entries[0];
+    auto replace_priority = TNumericLimits<int32>::Max();
+
+    for(auto& entry : bucket.Entries) {
+        const auto data = entry.Data;
+        if((entry.Key ^ data) == pos_key) {
+            replace = &entry;
+            break;
+        }
+
+        // prefer overwriting entries of older searches, then shallower ones
+        const int32 priority = UnpackDepth(data) + (UnpackAge(data) == age_ ? 256 : 0);
+        if(priority < replace_priority) {
+            replace = &entry;
+            replace_priority = priority;
+        }
+    }
+
+    auto stored_move = move;
+    if(stored_move == FMove::no_move && (replace->Key ^ replace->Data) == pos_key)
+        stored_move = UnpackMove(replace->Data);
+
+    const auto data = Pack(stored_move, score, depth, flag, age_);
+    replace->Key = pos_key ^ data;
+    replace->Data = data;
+}
+
+bool UTranspositionTable::Probe(const uint64 pos_key, const uint32 depth, const int32 alpha, const int32 beta,
+                                const uint32 ply, int32& score, FMove& move) const
+{
+    const auto& bucket = GetBucket(pos_key);
+    for(const auto& entry : bucket.Entries) {
+        const auto data = entry.Data;
+        if((entry.Key ^ data) != pos_key)
+            continue;
+
+        move = UnpackMove(data);
+        if(UnpackDepth(data) < depth)
+            return false;
+
+        score = UnpackScore(data);
+        if(score > IS_MATE) score -= ply;
+        else if(score < -IS_MATE) score += ply;
+
+        switch(UnpackFlag(data)) {
+            case EHashFlag::alpha:
+                if(score <= alpha) {
+                    score = alpha;
+                    return true;
+                }
+                break;
+            case EHashFlag::beta:
+                if(score >= beta) {
+                    score = beta;
+                    return true;
+                }
+                break;
+            case EHashFlag::exact:
+                return true;
+            default:
+                MAKE_SURE(false);
+                break;
+        }
+        return false;
+    }
+
+    move = FMove::no_move;
+    return false;
+}
+
+FMove UTranspositionTable::ProbeMove(const uint64 pos_key) const
+{
+    const auto& bucket = GetBucket(pos_key);
+    for(const auto& entry : bucket.Entries) {
+        const auto data = entry.Data;
+        if((entry.Key ^ data) == pos_key)
+            return UnpackMove(data);
+    }
+    return FMove::no_move;
+}
+
+TArray<FMove> UTranspositionTable::GetLine(UBoard* board, const UMoveGenerator* move_generator,
+                                           const uint32 depth) const
+{
+    TArray<FMove> arr;
+    MAKE_SURE(depth < max_depth);
+
+    auto m = ProbeMove(board->pos_key_);
+    while(m != FMove::no_move && arr.Num() < static_cast<int32>(depth)) {
+        if(move_generator->DoesMoveExist(m) && board->MakeMove(m)) {
+            arr.Add(m);
+        } else break;
+        m = ProbeMove(board->pos_key_);
+    }
+
+    // only the moves made here, the board may come with game moves of its own
+    for(auto i = 0; i < arr.Num(); ++i)
+        board->TakeMove();
+    return arr;
+}
@@ -88,6 +88,11 @@ uint32 FMove::GetScore() const
 	return score_;
 }
 
+uint32 FMove::Raw() const
+{
+	return move_;
+}
+
 FMove FMove::Create(const uint32 from, const uint32 to, const uint32 captured,
                     const uint32 promoted, const uint32 flags = 0)
 {
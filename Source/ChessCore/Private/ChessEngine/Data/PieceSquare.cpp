@@ -0,0 +1,191 @@
+// Copyright 2018 Emre Simsirli
+
+#include "PieceSquare.h"
+#include "PieceInfo.h"
+#include "Side.h"
+#include "Consts.h"
+#include "Util/Log.h"
+
+namespace
+{
+    const int32 PawnTable[64] = {
+        0, 0, 0, 0, 0, 0, 0, 0,
+        10, 10, 0, -10, -10, 0, 10, 10,
+        5, 0, 0, 5, 5, 0, 0, 5,
+        0, 0, 10, 20, 20, 10, 0, 0,
+        5, 5, 5, 10, 10, 5, 5, 5,
+        10, 10, 10, 20, 20, 10, 10, 10,
+        20, 20, 20, 30, 30, 20, 20, 20,
+        0, 0, 0, 0, 0, 0, 0, 0
+    };
+
+    const int32 KnightTable[64] = {
+        0, -10, 0, 0, 0, 0, -10, 0,
+        0, 0, 0, 5, 5, 0, 0, 0,
+        0, 0, 10, 10, 10, 10, 0, 0,
+        0, 0, 10, 20, 20, 10, 5, 0,
+        5, 10, 15, 20, 20, 15, 10, 5,
+        5, 10, 10, 20, 20, 10, 10, 5,
+        0, 0, 5, 10, 10, 5, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0
+    };
+
+    const int32 BishopTable[64] = {
+        0, 0, -10, 0, 0, -10, 0, 0,
+        0, 0, 0, 10, 10, 0, 0, 0,
+        0, 0, 10, 15, 15, 10, 0, 0,
+        0, 10, 15, 20, 20, 15, 10, 0,
+        0, 10, 15, 20, 20, 15, 10, 0,
+        0, 0, 10, 15, 15, 10, 0, 0,
+        0, 0, 0, 10, 10, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0
+    };
+
+    const int32 RookTable[64] = {
+        0, 0, 5, 10, 10, 5, 0, 0,
+        0, 0, 5, 10, 10, 5, 0, 0,
+        0, 0, 5, 10, 10, 5, 0, 0,
+        0, 0, 5, 10, 10, 5, 0, 0,
+        0, 0, 5, 10, 10, 5, 0, 0,
+        0, 0, 5, 10, 10, 5, 0, 0,
+        25, 25, 25, 25, 25, 25, 25, 25,
+        0, 0, 5, 10, 10, 5, 0, 0
+    };
+
+    const int32 QueenTable[64] = {
+        -10, -5, -5, 0, 0, -5, -5, -10,
+        -5, 0, 5, 0, 0, 0, 0, -5,
+        -5, 5, 5, 5, 5, 5, 0, -5,
+        0, 0, 5, 5, 5, 5, 0, 0,
+        0, 0, 5, 5, 5, 5, 0, 0,
+        -5, 0, 5, 5, 5, 5, 0, -5,
+        -5, 0, 0, 0, 0, 0, 0, -5,
+        -10, -5, -5, 0, 0, -5, -5, -10
+    };
+
+    const int32 KingTable[64] = {
+        20, 30, 10, 0, 0, 10, 30, 20,
+        20, 20, 0, 0, 0, 0, 20, 20,
+        -10, -20, -20, -20, -20, -20, -20, -10,
+        -20, -30, -30, -40, -40, -30, -30, -20,
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -30, -40, -40, -50, -50, -40, -40, -30
+    };
+
+    const int32 PawnEndgameTable[64] = {
+        0, 0, 0, 0, 0, 0, 0, 0,
+        5, 5, 5, 5, 5, 5, 5, 5,
+        10, 10, 10, 10, 10, 10, 10, 10,
+        20, 20, 20, 20, 20, 20, 20, 20,
+        35, 35, 35, 35, 35, 35, 35, 35,
+        60, 60, 60, 60, 60, 60, 60, 60,
+        90, 90, 90, 90, 90, 90, 90, 90,
+        0, 0, 0, 0, 0, 0, 0, 0
+    };
+
+    const int32 KnightEndgameTable[64] = {
+        -20, -10, -10, -10, -10, -10, -10, -20,
+        -10, 0, 0, 5, 5, 0, 0, -10,
+        -10, 0, 10, 10, 10, 10, 0, -10,
+        -10, 5, 10, 15, 15, 10, 5, -10,
+        -10, 5, 10, 15, 15, 10, 5, -10,
+        -10, 0, 10, 10, 10, 10, 0, -10,
+        -10, 0, 0, 5, 5, 0, 0, -10,
+        -20, -10, -10, -10, -10, -10, -10, -20
+    };
+
+    const int32 BishopEndgameTable[64] = {
+        -10, -5, -5, -5, -5, -5, -5, -10,
+        -5, 0, 0, 0, 0, 0, 0, -5,
+        -5, 0, 5, 5, 5, 5, 0, -5,
+        -5, 0, 5, 10, 10, 5, 0, -5,
+        -5, 0, 5, 10, 10, 5, 0, -5,
+        -5, 0, 5, 5, 5, 5, 0, -5,
+        -5, 0, 0, 0, 0, 0, 0, -5,
+        -10, -5, -5, -5, -5, -5, -5, -10
+    };
+
+    const int32 RookEndgameTable[64] = {
+        0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0,
+        10, 10, 10, 10, 10, 10, 10, 10,
+        0, 0, 0, 0, 0, 0, 0, 0
+    };
+
+    const int32 QueenEndgameTable[64] = {
+        -20, -10, -10, -5, -5, -10, -10, -20,
+        -10, 0, 0, 0, 0, 0, 0, -10,
+        -10, 0, 5, 5, 5, 5, 0, -10,
+        -5, 0, 5, 10, 10, 5, 0, -5,
+        -5, 0, 5, 10, 10, 5, 0, -5,
+        -10, 0, 5, 5, 5, 5, 0, -10,
+        -10, 0, 0, 0, 0, 0, 0, -10,
+        -20, -10, -10, -5, -5, -10, -10, -20
+    };
+
+    const int32 KingEndgameTable[64] = {
+        -50, -30, -30, -30, -30, -30, -30, -50,
+        -30, -30, 0, 0, 0, 0, -30, -30,
+        -30, -10, 20, 30, 30, 20, -10, -30,
+        -30, -10, 30, 40, 40, 30, -10, -30,
+        -30, -10, 30, 40, 40, 30, -10, -30,
+        -30, -10, 20, 30, 30, 20, -10, -30,
+        -30, -20, -10, 0, 0, -10, -20, -30,
+        -50, -40, -30, -20, -20, -30, -40, -50
+    };
+
+    const uint32 Mirror[64] = {
+        56, 57, 58, 59, 60, 61, 62, 63,
+        48, 49, 50, 51, 52, 53, 54, 55,
+        40, 41, 42, 43, 44, 45, 46, 47,
+        32, 33, 34, 35, 36, 37, 38, 39,
+        24, 25, 26, 27, 28, 29, 30, 31,
+        16, 17, 18, 19, 20, 21, 22, 23,
+        8, 9, 10, 11, 12, 13, 14, 15,
+        0, 1, 2, 3, 4, 5, 6, 7
+    };
+
+    const int32* const middlegame_tables[] = {
+        nullptr, PawnTable, KnightTable, BishopTable, RookTable, QueenTable, KingTable
+    };
+    const int32* const endgame_tables[] = {
+        nullptr, PawnEndgameTable, KnightEndgameTable, BishopEndgameTable,
+        RookEndgameTable, QueenEndgameTable, KingEndgameTable
+    };
+
+    int32 middlegame_scores[n_pieces][n_board_squares];
+    int32 endgame_scores[n_pieces][n_board_squares];
+}
+
+void PieceSquare::Initialize()
+{
+    for(uint32 piece = EPieceType::wp; piece <= EPieceType::bk; ++piece) {
+        const auto& piece_info = piece_infos[piece];
+        const auto is_white = piece_info.Side == ESide::white;
+        const auto type = is_white ? piece : piece - 6;
+        for(uint32 sq64 = 0; sq64 < n_board_squares; ++sq64) {
+            middlegame_scores[piece][sq64] = is_white
+                ? middlegame_tables[type][sq64] : -middlegame_tables[type][Mirror[sq64]];
+            endgame_scores[piece][sq64] = is_white
+                ? endgame_tables[type][sq64] : -endgame_tables[type][Mirror[sq64]];
+        }
+    }
+
+    LOGI("initialized");
+}
+
+int32 PieceSquare::GetMiddlegameScore(const uint32 piece, const uint32 sq64)
+{
+    return middlegame_scores[piece][sq64];
+}
+
+int32 PieceSquare::GetEndgameScore(const uint32 piece, const uint32 sq64)
+{
+    return endgame_scores[piece][sq64];
+}
@@ -0,0 +1,63 @@
+// Copyright 2018 Emre Simsirli
+
+#include "PosKey.h"
+#include "Consts.h"
+#include "Util/Log.h"
+
+// any value will do, but it must never change once keys are stored outside the process
+#define ZOBRIST_SEED 0x5DEECE66D2018ULL
+
+namespace
+{
+    uint64 piece_keys[n_pieces][n_board_squares_x];
+    uint64 side_key;
+    uint64 castle_keys[16];
+    uint64 en_passant_keys[8];
+
+    // splitmix64. the same seed gives the same keys on every machine and every run
+    uint64 NextKey(uint64& state)
+    {
+        auto z = state += 0x9E3779B97F4A7C15ULL;
+        z = (z ^ z >> 30) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ z >> 27) * 0x94D049BB133111EBULL;
+        return z ^ z >> 31;
+    }
+}
+
+void PosKey::Initialize()
+{
+    uint64 state = ZOBRIST_SEED;
+    for(auto& piece_key : piece_keys)
+        for(auto& j : piece_key)
+            j = NextKey(state);
+
+    side_key = NextKey(state);
+
+    for(auto& castle_key : castle_keys)
+        castle_key = NextKey(state);
+
+    for(auto& en_passant_key : en_passant_keys)
+        en_passant_key = NextKey(state);
+
+    LOGI("initialized");
+}
+
+uint64 PosKey::GetPieceKey(const uint32 piece_number, const uint32 square)
+{
+    return piece_keys[piece_number][square];
+}
+
+uint64 PosKey::GetSideKey()
+{
+    return side_key;
+}
+
+uint64 PosKey::GetCastleKey(const uint32 permission)
+{
+    return castle_keys[permission];
+}
+
+uint64 PosKey::GetEnPassantKey(const uint32 file)
+{
+    return en_passant_keys[file];
+}
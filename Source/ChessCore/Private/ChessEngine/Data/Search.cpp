@@ -1,6 +1,7 @@
 // Copyright 2018 Emre Simsirli
 
 #include "Search.h"
+#include "Square.h"
 
 FSearchInfo::FSearchInfo()
 {
@@ -15,17 +16,17 @@ void FSearchInfo::AddKiller(const uint32 ply, FMove& move)
 
 void FSearchInfo::AddHistory(const uint32 piece, const uint32 sq, const uint32 depth)
 {
-    History[piece][sq] += depth;
+    History[piece][ESquare::Sq64(sq)] += depth;
 }
 
-FMove FSearchInfo::GetKiller(const uint32 index, const uint32 ply)
+FMove FSearchInfo::GetKiller(const uint32 index, const uint32 ply) const
 {
     return Killers[index][ply];
 }
 
-uint32 FSearchInfo::GetHistory(const uint32 piece, const uint32 sq)
+uint32 FSearchInfo::GetHistory(const uint32 piece, const uint32 sq) const
 {
-    return History[piece][sq];
+    return History[piece][ESquare::Sq64(sq)];
 }
 
 void FSearchInfo::Clear()
@@ -36,6 +37,17 @@ void FSearchInfo::Clear()
     StopTimeActual = 0;
 
     TotalVisitedNodes = 0;
+    AllThreadsVisitedNodes = 0;
+    NullWindowResearches = 0;
+    AspirationResearches = 0;
+    PawnHashProbes = 0;
+    PawnHashHits = 0;
+    EvalCacheHits = 0;
+    EvalCacheMisses = 0;
+
+    CompletedDepth = 0;
+    BestMove = FMove::no_move;
+    RootBestMove = FMove::no_move;
 
 #ifdef DEBUG
     F_H = 0;
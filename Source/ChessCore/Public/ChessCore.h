@@ -0,0 +1,7 @@
+// Copyright 2018 Emre Simsirli
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+CHESSCORE_API DECLARE_LOG_CATEGORY_EXTERN(LogChessEngine, Log, All);
@@ -0,0 +1,40 @@
+// Copyright 2018 Emre Simsirli
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Debug.h"
+
+class FString;
+
+class CHESSCORE_API FBitboard
+{
+    uint64 board_;
+public:
+    FBitboard();
+    explicit FBitboard(uint64 board);
+    void SetSquare(uint32 sq);
+    void ClearSquare(uint32 sq);
+    uint32 Pop();
+    int32 Count() const;
+    void Empty();
+    bool IsEmpty() const;
+    uint64 Get() const;
+
+#ifdef DEBUG
+    FString ToString() const;
+#endif
+
+    // attack sets by 64 based square, sliders are looked up through magic indexing
+    static uint64 PawnAttacks(uint32 side, uint32 sq);
+    static uint64 KnightAttacks(uint32 sq);
+    static uint64 KingAttacks(uint32 sq);
+    static uint64 BishopAttacks(uint32 sq, uint64 occupancy);
+    static uint64 RookAttacks(uint32 sq, uint64 occupancy);
+    // squares strictly between two aligned squares, empty if they are not aligned
+    static uint64 Between(uint32 sq1, uint32 sq2);
+    // the whole line through two aligned squares, empty if they are not aligned
+    static uint64 Line(uint32 sq1, uint32 sq2);
+
+    static void Initialize();
+};
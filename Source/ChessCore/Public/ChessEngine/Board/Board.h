@@ -0,0 +1,103 @@
+// Copyright 2018 Emre Simsirli
+
+#pragma once
+
+#include "Debug.h"
+#include "Object.h"
+#include "Bitboard.h"
+#include "Move.h"
+#include "Consts.h"
+#include "Undo.h"
+#include "Position.h"
+#include "TranspositionTable.h"
+#include "MoveGenerator.h"
+#include "MoveExplorer.h"
+#include "Board.generated.h"
+
+class UMoveGenerator;
+class UTranspositionTable;
+class UMoveExplorer;
+class FMovePicker;
+
+UCLASS()
+class CHESSCORE_API UBoard : public UObject, public FPosition
+{
+    GENERATED_BODY()
+
+    friend UMoveGenerator;
+    friend UTranspositionTable;
+    friend UMoveExplorer;
+    friend FMovePicker;
+
+    uint32 ply_;
+    // preallocated so that making a move never touches the heap
+    FUndo history_[max_game_plies + max_depth];
+    int32 history_count_;
+
+    // copy-make: MakeMove saves the position here and TakeMove copies it back
+    bool copy_make_;
+    FPosition saved_positions_[max_depth];
+    int32 n_saved_positions_;
+
+public:
+    UBoard();
+
+    bool Set(const FString& fen);
+    void CopyFrom(const UBoard* other);
+    // the position and the moves that led to it, for putting the game back after
+    // the board was used for something else
+    void SaveTo(FPosition& position, TArray<FUndo>& history) const;
+    void RestoreFrom(const FPosition& position, const TArray<FUndo>& history);
+
+    // false if the move leaves the king in check or the undo stack is full,
+    // the board is unchanged then
+    bool MakeMove(const FMove& m);
+    void TakeMove();
+    // passes the turn, only for null move pruning. not allowed while in check.
+    // false if the undo stack is full
+    bool MakeNullMove();
+    void TakeNullMove();
+    bool IsInCheck();
+    // switches TakeMove between undoing the move and restoring the position saved by
+    // MakeMove. only between searches, when no move made in the other mode is left
+    void SetCopyMake(bool copy_make);
+    // static exchange evaluation. material the side to move gains on the target
+    // square of m when both sides keep recapturing with their cheapest piece
+    int32 See(const FMove& m) const;
+    // the key polyglot opening books index this position by
+    uint64 GeneratePolyglotKey() const;
+
+    // not theoretical. neither player can 
+    // be mated even if they play their best
+    bool IsDrawByMaterial() const;
+    bool HasTrifoldRepetition() const;
+    bool DoesViolateFiftyMoveRule() const;
+    
+    uint8 GetSide() const;
+    const FPieceList* GetPieceLocations() const;
+
+private:
+    void Reset();
+    void UpdateMaterial();
+    uint64 GeneratePositionKey() const;
+    uint64 GeneratePawnKey() const;
+
+    // only since the last capture, pawn move or null move, where the position could have been before
+    bool HasRepetition() const;
+    // no room left to undo another move, in the history or the copy-make saves
+    bool IsUndoStackFull() const;
+    bool IsAttacked(uint32 sq, uint8 attacking_side) const;
+    // pieces of attacking_side that attack the 64 based square with the given occupancy
+    uint64 AttackersTo(uint32 sq64, uint8 attacking_side, uint64 occupancy) const;
+
+    void AddPiece(uint32 sq, uint32 piece);
+    void MovePiece(uint32 from, uint32 to);
+    void ClearPiece(uint32 sq);
+
+#ifdef DEBUG
+public:
+    FString ToString() const;
+private:
+    bool IsOk() const;
+#endif
+};
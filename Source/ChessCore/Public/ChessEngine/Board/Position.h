@@ -0,0 +1,48 @@
+// Copyright 2018 Emre Simsirli
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Bitboard.h"
+#include "Consts.h"
+#include "PieceList.h"
+#include <type_traits>
+
+// the part of the board that every move changes. it is trivially copyable and a few
+// hundred bytes, so a search can restore it with one copy instead of undoing the move
+class CHESSCORE_API FPosition
+{
+protected:
+    uint8 b_[n_board_squares_x];
+    FBitboard pawns_[3];
+    FBitboard pieces_[n_pieces];
+    FBitboard occupancy_[3];
+    uint32 king_sq_[2];
+    uint32 en_passant_sq_;
+
+    FPieceList piece_locations_[n_pieces];
+    // slot of the piece on a square in its piece list
+    uint8 piece_slots_[n_board_squares_x];
+
+    uint32 n_big_pieces_[2]; // anything but pawn
+    uint32 n_major_pieces_[2]; // rook queen
+    uint32 n_minor_pieces_[2]; // bishop knight
+    uint32 material_score_[2];
+    // piece square sums from white's point of view
+    int32 middlegame_score_;
+    int32 endgame_score_;
+
+    uint32 cast_perm_;
+    uint64 pos_key_;
+    // pawns only, for the pawn hash table
+    uint64 pawn_key_;
+
+    uint8 side_;
+    // plies since the last capture or pawn move. the game can run past 255 of them
+    uint16 fifty_move_counter_;
+    // no position before a null move can repeat after it
+    uint16 plies_since_null_;
+};
+
+static_assert(std::is_trivially_copyable<FPosition>::value, "positions are saved and restored with plain copies");
+static_assert(sizeof(FPosition) <= 768, "every search ply keeps a copy of the position");
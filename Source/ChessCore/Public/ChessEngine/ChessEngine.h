@@ -0,0 +1,112 @@
+// Copyright 2018 Emre Simsirli
+
+#pragma once
+
+#include "Object.h"
+#include "Debug.h"
+#include "Search.h"
+#include "EventEnums.h"
+#include "ChessEngine.generated.h"
+
+class UTranspositionTable;
+class UMoveGenerator;
+class UMoveExplorer;
+class FMoveExplorerThread;
+class FMoveExplorerHelperThread;
+class FOpeningBook;
+class FMove;
+class UBoard;
+struct FSearchInfo;
+
+DECLARE_DELEGATE_OneParam(FMoveFoundDelegate, FMove)
+DECLARE_DELEGATE_TwoParams(FUpdateGameStateDelegate, EGameState::Type, EGameOverReason::Type)
+// depth, score. executed on the search thread
+DECLARE_DELEGATE_TwoParams(FIterationCompletedDelegate, int32, int32)
+
+UCLASS()
+class CHESSCORE_API UChessEngine : public UObject
+{
+    GENERATED_BODY()
+
+    friend UTranspositionTable;
+    friend UMoveGenerator;
+    friend UMoveExplorer;
+    friend FMoveExplorerThread;
+    friend FMoveExplorerHelperThread;
+
+    UPROPERTY()
+    UBoard* board_ = nullptr;
+    UPROPERTY()
+    UMoveGenerator* move_generator_ = nullptr;
+    UPROPERTY()
+    UMoveExplorer* move_explorer_ = nullptr;
+    FMoveExplorerThread* move_explorer_thread_ = nullptr;
+    TArray<FMoveExplorerHelperThread*> helper_threads_;
+    UPROPERTY()
+    UTranspositionTable* hash_table_ = nullptr;
+    FOpeningBook* opening_book_ = nullptr;
+
+public:
+    bool bIsMultiplayer = true;
+    FSearchInfo* SearchInfo = nullptr;
+    FMoveSearchParams SearchParams;
+    FMoveFoundDelegate MoveFoundDelegate;
+    FUpdateGameStateDelegate UpdateGameStateDelegate;
+    FIterationCompletedDelegate IterationCompletedDelegate;
+
+    UChessEngine();
+    ~UChessEngine();
+    void Set(FString& fen) const;
+
+    // false if the move is illegal or the game is too long to take another one
+    bool MakeMove(FMove& move) const;
+    void TakeMove() const;
+    TArray<FMove> GenerateMoves(uint32 sq) const;
+    void Search();
+    // searches on the calling thread instead of the search thread
+    FMove FindBestMove();
+    void StopSearch() const;
+    void ClearHash() const;
+    // finds the legal move written in coordinate notation, e.g. e7e8q
+    bool ParseMove(const FString& str, FMove& move) const;
+    TArray<FMove> GetPrincipalVariation(int32 depth) const;
+    uint8 GetSide() const;
+    // searches the current position synchronously with 1, 2, 4.. max_threads
+    // threads and reports nodes per second for each
+    FString ThreadScaling(int32 depth, int32 max_threads = 16);
+    // void SaveGame();
+    // void LoadGame();
+
+    void GetPieces(const TFunction<void(uint32, uint32)>& on_piece) const;
+
+    // creates n instances and lets them search concurrently, each on its own
+    // thread, and reports the aggregate nodes per second for 1, 2, 4.. max_instances
+    static FString InstanceScaling(int32 depth, int32 max_instances = 16);
+
+    // leaf nodes of the legal move tree of the current position
+    int64 Perft(int32 depth) const;
+    // perft split by root move
+    FString Divide(int32 depth) const;
+    // runs the well known perft positions up to max_depth and reports
+    // correctness, time and nodes per second for each depth
+    FString PerftSuite(int32 max_depth = 4) const;
+    // searches a fixed set of positions to a fixed depth on one thread with a
+    // fresh hash table each. the node total changes only if the search does
+    FString Bench(int32 depth = 6);
+    // runs perft over the perft positions and the bench searches once with make/unmake
+    // and once with copy-make, and reports the time each mode took
+    FString CompareCopyMake(int32 perft_depth = 5, int32 search_depth = 8);
+
+    // builds the read-only tables shared by every engine instance. safe to call more than once
+    static void Initialize();
+
+private:
+    void CheckGameOver() const;
+    void UpdateHelperThreads();
+    // runs a benchmark on a fixed setup: no helpers, clock or book and a small hash.
+    // the game and the search params are put back afterwards
+    FString RunBenchmark(const TFunction<FString()>& benchmark);
+    // opens the book first if the search params name another one
+    bool ProbeOpeningBook(FMove& move);
+    void Perft(int32 depth, int64* leaf_nodes) const;
+};
@@ -0,0 +1,21 @@
+// Copyright 2018 Emre Simsirli
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Containers/Array.h"
+
+// static evaluations by position key, mostly for stand pat scores
+// that quiescence reaches again through transpositions
+class CHESSCORE_API FEvalHashTable
+{
+    // upper key bits verify the entry, the lower 16 bits hold the score
+    TArray<uint64> entries_;
+
+public:
+    FEvalHashTable();
+
+    bool Probe(uint64 pos_key, int32& score) const;
+    void Store(uint64 pos_key, int32 score);
+    void Clear();
+};
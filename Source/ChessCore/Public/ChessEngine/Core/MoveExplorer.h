@@ -0,0 +1,110 @@
+﻿// Copyright 2018 Emre Simsirli
+
+#pragma once
+
+#include "Object.h"
+#include "Runnable.h"
+#include "ThreadSafeBool.h"
+#include "MoveExplorer.generated.h"
+
+class UChessEngine;
+class UMoveGenerator;
+class UBoard;
+class FMove;
+class FPawnHashTable;
+class FEvalHashTable;
+struct FSearchInfo;
+
+UCLASS()
+class CHESSCORE_API UMoveExplorer : public UObject
+{
+    GENERATED_BODY()
+
+    friend UMoveGenerator;
+
+    UChessEngine* engine_;
+    UBoard* board_;
+    UMoveGenerator* move_generator_;
+    FSearchInfo* search_info_;
+    FPawnHashTable* pawn_table_ = nullptr;
+    FEvalHashTable* eval_table_ = nullptr;
+
+public:
+    static void Initialize();
+
+    ~UMoveExplorer();
+
+    void SetContext(UChessEngine* engine, UBoard* board, UMoveGenerator* move_generator,
+                    FSearchInfo* search_info);
+
+    FMove Search() const;
+    // empties the pawn and eval caches, which otherwise outlive every search
+    void ClearCaches() const;
+    void PrepareSearch() const;
+    void SearchAsHelper(uint32 helper_index) const;
+
+private:
+    void IterativeDeepening(int32 start_depth) const;
+
+    // cached by position key
+    int32 Evaluate() const;
+    int32 EvaluatePosition() const;
+    // pawn structure only, from white's point of view
+    void EvaluatePawns(int32& middlegame, int32& endgame) const;
+    int32 AlphaBeta(int32 alpha, int32 beta, uint32 depth, bool do_null) const;
+    int32 Quiescence(int32 alpha, int32 beta) const;
+
+    void CheckTimeIsUp() const;
+};
+
+class FMoveExplorerThread : FRunnable
+{
+    UChessEngine* engine_;
+    FRunnableThread* thread_;
+    FThreadSafeBool is_killing_;
+    FThreadSafeBool is_stopping_search_;
+
+    FEvent* event_;
+
+public:
+    explicit FMoveExplorerThread(UChessEngine* engine);
+    ~FMoveExplorerThread();
+
+    uint32 Run() override;
+    void Stop() override;
+
+    void StartSearch();
+
+private:
+	void DoStop();
+    void StopSearch();
+};
+
+// lazy smp worker. searches its own copy of the board
+// and only communicates through the shared hash table
+class FMoveExplorerHelperThread : FRunnable
+{
+    FRunnableThread* thread_;
+    FThreadSafeBool is_killing_;
+
+    FEvent* start_event_;
+    FEvent* done_event_;
+
+    uint32 index_;
+    UBoard* board_;
+    UMoveGenerator* move_generator_;
+    UMoveExplorer* move_explorer_;
+    FSearchInfo* search_info_;
+
+public:
+    FMoveExplorerHelperThread(UChessEngine* engine, uint32 index);
+    ~FMoveExplorerHelperThread();
+
+    uint32 Run() override;
+    void Stop() override;
+
+    void StartSearch(const UBoard* board);
+    void StopSearch();
+
+    const FSearchInfo* GetSearchInfo() const;
+};
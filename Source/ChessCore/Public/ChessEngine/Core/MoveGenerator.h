@@ -0,0 +1,88 @@
+// Copyright 2018 Emre Simsirli
+
+#pragma once
+
+#include "Object.h"
+#include "Containers/Array.h"
+#include "Move.h"
+#include "MoveList.h"
+#include "MoveGenerator.generated.h"
+
+class UChessEngine;
+class UBoard;
+struct FSearchInfo;
+
+namespace EMoveGenType
+{
+    enum Type
+    {
+        all,
+        captures, // captures and queen promotions
+        quiets // everything else, including under promotions
+    };
+}
+
+// what the side to move has to respect for a move to be legal, 64 based
+struct FCheckInfo
+{
+    uint32 KingSq;
+    uint64 Checkers;
+    uint64 Pinned;
+    // squares that resolve a single check, everything when not in check
+    uint64 Evasions;
+};
+
+UCLASS()
+class CHESSCORE_API UMoveGenerator : public UObject
+{
+    GENERATED_BODY()
+
+    const UChessEngine* engine_;
+    UBoard* board_;
+    FSearchInfo* search_info_;
+
+public:
+    void SetContext(const UChessEngine* engine, UBoard* board, FSearchInfo* search_info);
+
+    void GenerateMoves(FMoveList& moves) const;
+    void GenerateMoves(uint32 sq, FMoveList& moves) const;
+    // these two append to the list so that earlier moves can be kept in place
+    void GenerateCaptures(FMoveList& moves) const;
+    void GenerateQuiets(FMoveList& moves) const;
+    // legal moves only, no need to make them to find out
+    void GenerateLegalMoves(FMoveList& moves) const;
+    void GenerateLegalMoves(uint32 sq, FMoveList& moves) const;
+    bool HasLegalMove() const;
+    bool DoesMoveExist(const FMove& m) const;
+    // whether the move could be generated in this position, legality is not checked
+    bool IsPseudoLegal(const FMove& m) const;
+    // whether a pseudo legal move leaves the own king safe
+    bool IsLegal(const FMove& m) const;
+
+    // whether the move belongs to the captures set
+    static bool IsNoisy(const FMove& m);
+
+    static void Initialize();
+
+private:
+    FCheckInfo GetCheckInfo() const;
+    bool IsLegal(const FMove& m, const FCheckInfo& info) const;
+    void RemoveIllegalMoves(FMoveList& moves) const;
+
+    void GenerateSideMoves(EMoveGenType::Type type, FMoveList& moves) const;
+    void GeneratePieceMoves(uint32 sq, EMoveGenType::Type type, FMoveList& moves) const;
+    void GeneratePawnMoves(uint32 sq, EMoveGenType::Type type, FMoveList& moves) const;
+    void GenerateSlidingMoves(uint32 sq, EMoveGenType::Type type, FMoveList& moves) const;
+    void GenerateNonSlidingMoves(uint32 sq, EMoveGenType::Type type, FMoveList& moves) const;
+    void GenerateCastlingMoves(FMoveList& moves) const;
+    void AddAttackMoves(uint32 sq, uint64 attacks, EMoveGenType::Type type, FMoveList& moves) const;
+
+    void AddQuietMove(FMove move, FMoveList& moves) const;
+    void AddCaptureMove(FMove move, FMoveList& moves) const;
+    void AddPromotionMove(FMove move, FMoveList& moves) const;
+    void AddEnPassantMove(FMove move, FMoveList& moves) const;
+
+    void AddPawnRegularMove(uint32 from, uint32 to, EMoveGenType::Type type, FMoveList& moves) const;
+    void AddPawnCaptureMove(uint32 from, uint32 to,
+                            uint32 captured, FMoveList& moves) const;
+};
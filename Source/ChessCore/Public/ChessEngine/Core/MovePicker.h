@@ -0,0 +1,63 @@
+// Copyright 2018 Emre Simsirli
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Move.h"
+#include "MoveList.h"
+
+class UBoard;
+class UMoveGenerator;
+struct FSearchInfo;
+
+namespace EPickerStage
+{
+    enum Type
+    {
+        hash_move,
+        generate_captures,
+        good_captures,
+        killers,
+        generate_quiets,
+        quiets,
+        bad_captures,
+        generate_evasions,
+        evasions,
+        done
+    };
+}
+
+// hands out the moves of a node one by one, generating and ordering them
+// lazily so that a cutoff on an early move skips the rest of the work
+class CHESSCORE_API FMovePicker
+{
+    const UBoard* board_;
+    const UMoveGenerator* move_generator_;
+    const FSearchInfo* search_info_;
+
+    FMove hash_move_;
+    FMove killers_[2];
+    uint32 ply_;
+    bool captures_only_;
+
+    EPickerStage::Type stage_;
+    FMoveList moves_;
+    int32 index_;
+    int32 capture_end_;
+    int32 bad_capture_end_;
+    int32 killer_index_;
+
+public:
+    FMovePicker(const UBoard* board, const UMoveGenerator* move_generator,
+                const FSearchInfo* search_info, const FMove& hash_move, uint32 ply);
+    // captures and queen promotions that do not lose material, for the quiescence
+    // search. every legal move instead when in check, since standing pat is not an option
+    FMovePicker(const UBoard* board, const UMoveGenerator* move_generator, bool in_check);
+
+    bool Next(FMove& move);
+
+private:
+    void PickBest(int32 begin, int32 end);
+    bool IsLosingCapture(const FMove& move) const;
+    bool IsKiller(const FMove& move) const;
+};
@@ -0,0 +1,42 @@
+// Copyright 2018 Emre Simsirli
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Containers/Array.h"
+#include "UnrealString.h"
+#include "Move.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+class UBoard;
+class UMoveGenerator;
+
+// polyglot .bin book: 16 byte big endian entries of key, move, weight and learn
+// data, sorted by key. mapped into memory rather than read where the platform can
+class CHESSCORE_API FOpeningBook
+{
+    FString path_;
+    IMappedFileHandle* mapped_file_;
+    IMappedFileRegion* mapped_region_;
+    // the whole file, only when it could not be mapped
+    TArray<uint8> loaded_;
+    const uint8* entries_;
+    int64 n_entries_;
+
+public:
+    FOpeningBook();
+    ~FOpeningBook();
+
+    // closes the current book first. the path is kept even if opening fails,
+    // so that a missing book is not looked for again before every move
+    bool Open(const FString& path);
+    void Close();
+    const FString& GetPath() const;
+
+    // one of the legal book moves of the position, chosen at random by weight
+    bool Probe(const UBoard* board, const UMoveGenerator* move_generator, FMove& move) const;
+
+private:
+    uint64 GetKey(int64 index) const;
+};
@@ -0,0 +1,29 @@
+// Copyright 2018 Emre Simsirli
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Containers/Array.h"
+
+// pawn structure scores from white's point of view
+struct FPawnEntry
+{
+    uint64 Key;
+    int32 Middlegame;
+    int32 Endgame;
+};
+
+// pawn structures repeat across almost every node of a search,
+// so their evaluation is cached by the pawn key
+class CHESSCORE_API FPawnHashTable
+{
+    TArray<FPawnEntry> entries_;
+
+public:
+    FPawnHashTable();
+
+    // the entry the key maps to. the caller evaluates and
+    // fills it in when the stored key does not match
+    FPawnEntry& GetEntry(uint64 pawn_key);
+    void Clear();
+};
@@ -0,0 +1,66 @@
+// Copyright 2018 Emre Simsirli
+
+#pragma once
+
+#include "Object.h"
+#include "Containers/Array.h"
+#include "Move.h"
+#include "TranspositionTable.generated.h"
+
+class UMoveExplorer;
+class UMoveGenerator;
+class UBoard;
+
+namespace EHashFlag
+{
+    enum Type
+    {
+        none, alpha, beta, exact
+    };
+}
+
+// key is stored xor'ed with data so that a torn write
+// from another search thread is detected at probe time
+struct FHashEntry
+{
+    uint64 Key;
+    uint64 Data;
+};
+
+struct alignas(64) FHashBucket
+{
+    static constexpr auto n_entries = 4;
+    FHashEntry Entries[n_entries];
+};
+
+// the one table all search threads share, hence the xor'ed keys and no locking. the
+// pawn and eval caches are small enough for every UMoveExplorer to keep its own instead
+UCLASS()
+class CHESSCORE_API UTranspositionTable : public UObject
+{
+    GENERATED_BODY()
+
+    friend UMoveExplorer;
+
+    FHashBucket* buckets_ = nullptr;
+    uint64 n_buckets_ = 0;
+    uint32 size_mb_ = 0;
+    uint8 age_ = 0;
+
+public:
+    ~UTranspositionTable();
+
+    void Resize(uint32 size_mb);
+    void NewSearch();
+    void Clear();
+
+    void Store(uint64 pos_key, const FMove& move, int32 score, uint32 depth, EHashFlag::Type flag, uint32 ply);
+    bool Probe(uint64 pos_key, uint32 depth, int32 alpha, int32 beta, uint32 ply,
+               int32& score, FMove& move) const;
+    FMove ProbeMove(uint64 pos_key) const;
+
+    TArray<FMove> GetLine(UBoard* board, const UMoveGenerator* move_generator, uint32 depth) const;
+
+private:
+    FHashBucket& GetBucket(uint64 pos_key) const;
+};
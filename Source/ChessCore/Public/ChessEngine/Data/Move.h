@@ -8,7 +8,7 @@
 class FString;
 
 USTRUCT()
-struct CHESS_API FMoveData
+struct CHESSCORE_API FMoveData
 {
     GENERATED_BODY()
 
@@ -21,7 +21,7 @@ struct CHESS_API FMoveData
     };
 };
 
-class CHESS_API FMove
+class CHESSCORE_API FMove
 {
 public:
     static const uint32 flag_en_passant = 0x40000;
@@ -53,6 +53,8 @@ public:
     void SetScore(uint32 s);
     uint32 GetScore() const;
 
+    uint32 Raw() const;
+
     static FMove Create(uint32 from, uint32 to, uint32 captured, uint32 promoted, uint32 flags);
 
     FString ToString() const;
@@ -0,0 +1,41 @@
+// Copyright 2018 Emre Simsirli
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Consts.h"
+#include "Debug.h"
+#include "Move.h"
+
+// fixed capacity move container which lives on the stack, so
+// that generating moves for a node never touches the heap
+struct CHESSCORE_API FMoveList
+{
+    FMove Moves[max_position_moves];
+    int32 Count = 0;
+
+    FORCEINLINE void Add(const FMove& move)
+    {
+        MAKE_SURE(Count < max_position_moves);
+        Moves[Count++] = move;
+    }
+
+    FORCEINLINE int32 Num() const { return Count; }
+    FORCEINLINE void Reset() { Count = 0; }
+
+    FORCEINLINE FMove& operator[](const int32 index) { return Moves[index]; }
+    FORCEINLINE const FMove& operator[](const int32 index) const { return Moves[index]; }
+
+    FORCEINLINE FMove* begin() { return Moves; }
+    FORCEINLINE FMove* end() { return Moves + Count; }
+    FORCEINLINE const FMove* begin() const { return Moves; }
+    FORCEINLINE const FMove* end() const { return Moves + Count; }
+
+    FMove* Find(const FMove& move)
+    {
+        for(auto& m : *this)
+            if(m == move)
+                return &m;
+        return nullptr;
+    }
+};
@@ -11,7 +11,7 @@ enum EPieceType
     empty, wp, wn, wb, wr, wq, wk, bp, bn, bb, br, bq, bk
 };
 
-struct CHESS_API FPieceInfo
+struct CHESSCORE_API FPieceInfo
 {
     bool bIsBig;
     bool bIsMajor;
@@ -0,0 +1,42 @@
+// Copyright 2018 Emre Simsirli
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Consts.h"
+#include "Debug.h"
+
+// fixed capacity list of the squares one piece type stands on. the board keeps every
+// piece's slot in it, so moving or removing a piece never has to search the list
+struct CHESSCORE_API FPieceList
+{
+    uint8 Squares[max_piece_count];
+    int32 Count = 0;
+
+    // returns the slot the square was put in
+    FORCEINLINE int32 Add(const uint32 sq)
+    {
+        MAKE_SURE(Count < max_piece_count);
+        Squares[Count] = sq;
+        return Count++;
+    }
+
+    // fills the slot with the last square, returns that square
+    FORCEINLINE uint32 RemoveAtSwap(const int32 slot)
+    {
+        MAKE_SURE(slot < Count);
+        Squares[slot] = Squares[--Count];
+        return Squares[slot];
+    }
+
+    FORCEINLINE int32 Num() const { return Count; }
+    FORCEINLINE void Reset() { Count = 0; }
+
+    FORCEINLINE uint8& operator[](const int32 index) { return Squares[index]; }
+    FORCEINLINE uint32 operator[](const int32 index) const { return Squares[index]; }
+
+    FORCEINLINE uint8* begin() { return Squares; }
+    FORCEINLINE uint8* end() { return Squares + Count; }
+    FORCEINLINE const uint8* begin() const { return Squares; }
+    FORCEINLINE const uint8* end() const { return Squares + Count; }
+};
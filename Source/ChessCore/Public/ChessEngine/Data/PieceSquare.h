@@ -0,0 +1,15 @@
+// Copyright 2018 Emre Simsirli
+
+#pragma once
+
+#include "CoreTypes.h"
+
+// piece square scores from white's point of view,
+// black pieces are mirrored and count negative
+namespace PieceSquare
+{
+    int32 GetMiddlegameScore(uint32 piece, uint32 sq64);
+    int32 GetEndgameScore(uint32 piece, uint32 sq64);
+
+    void Initialize();
+}
@@ -0,0 +1,17 @@
+// Copyright 2018 Emre Simsirli
+
+#pragma once
+
+#include "CoreTypes.h"
+
+// position keys laid out the way polyglot opening books index them. kept apart
+// from PosKey, whose keys the search is free to change
+namespace PolyglotKey
+{
+    // rank and file from 0, rank 0 being white's back rank
+    uint64 GetPieceKey(uint32 piece, uint32 file, uint32 rank);
+    uint64 GetCastleKey(uint32 permission);
+    uint64 GetEnPassantKey(uint32 file);
+    // only hashed when white is to move
+    uint64 GetSideKey();
+}
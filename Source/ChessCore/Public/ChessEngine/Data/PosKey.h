@@ -9,6 +9,8 @@ namespace PosKey
     uint64 GetPieceKey(uint32 piece_number, uint32 square);
     uint64 GetSideKey();
     uint64 GetCastleKey(uint32 permission);
+    // only the file matters, the rank follows from the side to move
+    uint64 GetEnPassantKey(uint32 file);
 
     void Initialize();
 }
@@ -0,0 +1,118 @@
+// Copyright 2018 Emre Simsirli
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "ObjectMacros.h"
+#include "Consts.h"
+#include "Move.h"
+#include "Debug.h"
+#include "ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter64.h"
+#include "Search.generated.h"
+
+USTRUCT(BlueprintType)
+struct CHESSCORE_API FMoveSearchParams
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Chess|Difficulty", 
+		meta = (ClampMax = 32, ClampMin = 1, ToolTip = "Max depth the search can go"))
+    int32 Depth = 1;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Chess|Difficulty", 
+		meta = (ClampMax = 30, ClampMin = 0, ToolTip = "Search will stop after this seconds"))
+    float TimeSet = 0;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Chess|Difficulty", 
+		meta = (ToolTip = "Should the search use null move cut"))
+    bool UseNullCut = true;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Chess|Difficulty", 
+		meta = (ToolTip = "Should late quiet moves be searched with reduced depth"))
+    bool UseLateMoveReductions = true;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Chess|Difficulty", 
+		meta = (ToolTip = "Should hopeless quiet moves be skipped near the leaves"))
+    bool UseFutilityPruning = true;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Chess|Difficulty", 
+		meta = (ToolTip = "Should nodes with a static eval well above beta be cut near the leaves"))
+    bool UseReverseFutilityPruning = true;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Chess|Difficulty", 
+		meta = (ToolTip = "Should nodes with a static eval well below alpha drop into quiescence"))
+    bool UseRazoring = true;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Chess|Engine", 
+		meta = (ClampMax = 1024, ClampMin = 1, ToolTip = "Transposition table size in megabytes"))
+    int32 HashSize = 64;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Chess|Engine", 
+		meta = (ClampMax = 63, ClampMin = 0, ToolTip = "Extra search threads sharing the transposition table"))
+    int32 HelperThreads = 0;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Chess|Engine", 
+		meta = (ToolTip = "Should the search restore a saved copy of the position instead of undoing each move"))
+    bool UseCopyMake = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Chess|Engine", 
+		meta = (ToolTip = "Should book moves be played without searching while the opening book has any"))
+    bool UseOpeningBook = true;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Chess|Engine", 
+		meta = (ToolTip = "Polyglot .bin opening book, none when empty"))
+    FString OpeningBook;
+};
+
+struct CHESSCORE_API FSearchInfo
+{
+    // seconds, as given by FPlatformTime
+    double StartTime = 0;
+    // zero when the search is not limited by time
+    double StopTimeSet = 0;
+    double StopTimeActual = 0;
+    // milliseconds, set from another thread on ponderhit. that can come before the
+    // search cleared this info, so Clear leaves it alone. zero when there is none
+    FThreadSafeCounter64 PonderStopTimeMs;
+
+    // set by other search threads as well
+    FThreadSafeBool bStopRequested;
+
+    int64 TotalVisitedNodes = 0;
+    // main thread only, includes helper nodes
+    int64 AllThreadsVisitedNodes = 0;
+    // pvs moves that beat the null window and iterations that fell outside the aspiration window
+    int64 NullWindowResearches = 0;
+    int64 AspirationResearches = 0;
+    int64 PawnHashProbes = 0;
+    int64 PawnHashHits = 0;
+    int64 EvalCacheHits = 0;
+    int64 EvalCacheMisses = 0;
+
+    // result of the last fully searched iteration
+    int32 CompletedDepth = 0;
+    FMove BestMove;
+    // last root move that raised alpha, also inside an iteration that is not complete yet
+    FMove RootBestMove;
+
+#ifdef DEBUG
+    // fail high
+    float F_H = 0;
+    // fail high first
+    float F_H_F = 0;
+#endif
+
+    // heuristics for better move ordering
+    uint32 History[n_pieces][n_board_squares];
+    FMove Killers[2][max_depth];
+
+    FSearchInfo();
+    void AddKiller(uint32 ply, FMove& move);
+    // sq is a 120 based square, the table is indexed by the 64 based one
+    void AddHistory(uint32 piece, uint32 sq, uint32 depth);
+    FMove GetKiller(uint32 index, uint32 ply) const;
+    uint32 GetHistory(uint32 piece, uint32 sq) const;
+
+    void Clear();
+};
@@ -4,19 +4,23 @@
 
 #include "Move.h"
 
-struct CHESS_API FUndo
+struct CHESSCORE_API FUndo
 {
     FMove move;
     uint32 cast_perm;
     uint32 en_passant_sq;
     uint32 fifty_move_counter;
+    uint32 plies_since_null;
     uint64 pos_key;
 
+    FUndo() : FUndo(FMove::no_move) {}
+
     explicit FUndo(const FMove& m) : move(m)
     {
         cast_perm = 0;
         en_passant_sq = 0;
         fifty_move_counter = 0;
+        plies_since_null = 0;
         pos_key = 0;
     }
 };
@@ -0,0 +1,16 @@
+// Copyright 2018 Emre Simsirli
+
+#pragma once
+
+constexpr auto n_board_squares_x = 120;
+constexpr auto n_board_squares = 64;
+constexpr auto n_pieces = 13;
+constexpr auto max_depth = 64;
+// plies a game can take, the board keeps one undo for each and for every search ply on top
+constexpr auto max_game_plies = 2048;
+constexpr auto max_position_moves = 256;
+// eight promoted pawns and the two a side starts with
+constexpr auto max_piece_count = 10;
+
+constexpr auto infinite_score = 30000;
+constexpr auto mate_score = 29000;
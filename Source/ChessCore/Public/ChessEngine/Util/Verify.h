@@ -6,7 +6,7 @@
 #include "PieceInfo.h"
 #include "Square.h"
 
-class CHESS_API Verification
+class CHESSCORE_API Verification
 {
 public:
     FORCEINLINE static bool IsSquareOnBoard(const uint32 sq)
@@ -0,0 +1,22 @@
+// Copyright 2018 Emre Simsirli
+
+using UnrealBuildTool;
+using System.Collections.Generic;
+
+// headless console build of the engine speaking the uci protocol
+public class ChessUciTarget : TargetRules
+{
+	public ChessUciTarget(TargetInfo Target) : base(Target)
+	{
+		Type = TargetType.Program;
+		LinkType = TargetLinkType.Monolithic;
+		LaunchModuleName = "ChessUci";
+
+		bCompileAgainstEngine = false;
+		bCompileAgainstCoreUObject = true;
+		bBuildDeveloperTools = false;
+		bCompileICU = false;
+		bUseLoggingInShipping = true;
+		bIsBuildingConsoleApplication = true;
+	}
+}
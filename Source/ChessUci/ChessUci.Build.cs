@@ -0,0 +1,15 @@
+// Copyright 2018 Emre Simsirli
+
+using UnrealBuildTool;
+
+public class ChessUci : ModuleRules
+{
+	public ChessUci(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PrivateIncludePathModuleNames.Add("Launch");
+		PrivateDependencyModuleNames.AddRange(new string[] {
+		    "Core", "CoreUObject", "ApplicationCore", "Projects", "ChessCore" });
+	}
+}
@@ -0,0 +1,27 @@
+// Copyright 2018 Emre Simsirli
+
+#include "RequiredProgramMainCPPInclude.h"
+#include "UObject/UObjectBase.h"
+#include "UciSession.h"
+
+IMPLEMENT_APPLICATION(ChessUci, "ChessUci");
+
+INT32_MAIN_INT32_ARGC_TCHAR_ARGV()
+{
+    GEngineLoop.PreInit(ArgC, ArgV);
+    ProcessNewlyLoadedUObjects();
+
+    {
+        // "ChessUci -bench" prints the bench signature and exits, for scripts
+        FUciSession session;
+        if(FParse::Param(FCommandLine::Get(), TEXT("bench")))
+            session.HandleCommand(TEXT("bench"));
+        else
+            session.Run();
+    }
+
+    FEngineLoop::AppPreExit();
+    FModuleManager::Get().UnloadModulesAtShutdown();
+    FEngineLoop::AppExit();
+    return 0;
+}
@@ -0,0 +1,308 @@
+// Copyright 2018 Emre Simsirli
+
+#include "UciSession.h"
+#include "ChessEngine.h"
+#include "Consts.h"
+#include "Side.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformProcess.h"
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#define ENGINE_NAME "Chess"
+#define ENGINE_AUTHOR "Emre Simsirli"
+// milliseconds kept back from every move for the gui and the pipe
+#define MOVE_OVERHEAD 50
+// assumed when the gui does not send movestogo
+#define DEFAULT_MOVES_TO_GO 30
+
+namespace
+{
+    const auto start_fen = TEXT("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
+
+    float AllocateTime(const int32 time_left, const int32 increment, const int32 moves_to_go)
+    {
+        const auto n_moves = moves_to_go > 0 ? moves_to_go : DEFAULT_MOVES_TO_GO;
+        auto ms = FMath::Min(time_left / n_moves + increment * 3 / 4, time_left / 2);
+        ms = FMath::Max(ms - MOVE_OVERHEAD, 10);
+        return ms / 1000.f;
+    }
+
+    FString ScoreToString(const int32 score)
+    {
+        if(score > mate_score - max_depth)
+            return FString::Printf(TEXT("mate %d"), (mate_score - score + 1) / 2);
+        if(score < -mate_score + max_depth)
+            return FString::Printf(TEXT("mate %d"), -(mate_score + score) / 2);
+        return FString::Printf(TEXT("cp %d"), score);
+    }
+}
+
+FUciSession::FUciSession()
+    : is_searching_(false), ponder_hit_time_(0)
+{
+    engine_ = NewObject<UChessEngine>();
+    engine_->AddToRoot();
+
+    // the game reacts to these, a uci gui keeps track of the game itself
+    engine_->UpdateGameStateDelegate.BindLambda([](EGameState::Type, EGameOverReason::Type) -> void {});
+    engine_->IterationCompletedDelegate.BindRaw(this, &FUciSession::OnIterationCompleted);
+}
+
+FUciSession::~FUciSession()
+{
+    Stop();
+    engine_->RemoveFromRoot();
+}
+
+void FUciSession::Run()
+{
+    std::string line;
+    while(std::getline(std::cin, line)) {
+        if(!HandleCommand(FString(UTF8_TO_TCHAR(line.c_str()))))
+            break;
+    }
+}
+
+bool FUciSession::HandleCommand(const FString& line)
+{
+    TArray<FString> tokens;
+    line.ParseIntoArrayWS(tokens);
+    if(tokens.Num() == 0)
+        return true;
+
+    const auto& command = tokens[0];
+    if(command == TEXT("uci")) {
+        Uci();
+    } else if(command == TEXT("isready")) {
+        Send(TEXT("readyok"));
+    } else if(command == TEXT("setoption")) {
+        SetOption(tokens);
+    } else if(command == TEXT("ucinewgame")) {
+        WaitForSearch();
+        engine_->ClearHash();
+    } else if(command == TEXT("position")) {
+        WaitForSearch();
+        Position(tokens);
+    } else if(command == TEXT("go")) {
+        WaitForSearch();
+        Go(tokens);
+    } else if(command == TEXT("stop")) {
+        Stop();
+    } else if(command == TEXT("ponderhit")) {
+        PonderHit();
+    } else if(command == TEXT("perft")) {
+        WaitForSearch();
+        Perft(tokens);
+    } else if(command == TEXT("bench")) {
+        WaitForSearch();
+        Bench(tokens);
+    } else if(command == TEXT("quit")) {
+        return false;
+    }
+    return true;
+}
+
+void FUciSession::Uci() const
+{
+    Send(TEXT("id name " ENGINE_NAME));
+    Send(TEXT("id author " ENGINE_AUTHOR));
+    Send(FString::Printf(TEXT("option name Hash type spin default %d min 1 max 1024"),
+        engine_->SearchParams.HashSize));
+    Send(FString::Printf(TEXT("option name Threads type spin default %d min 1 max 64"),
+        engine_->SearchParams.HelperThreads + 1));
+    Send(TEXT("option name Ponder type check default false"));
+    Send(FString::Printf(TEXT("option name OwnBook type check default %s"),
+        engine_->SearchParams.UseOpeningBook ? TEXT("true") : TEXT("false")));
+    Send(TEXT("option name BookFile type string default <empty>"));
+    Send(TEXT("uciok"));
+}
+
+void FUciSession::SetOption(const TArray<FString>& tokens)
+{
+    // setoption name <name> value <value>
+    if(tokens.Num() < 5 || tokens[1] != TEXT("name") || tokens[3] != TEXT("value"))
+        return;
+
+    WaitForSearch();
+    const auto value = FCString::Atoi(*tokens[4]);
+    if(tokens[2] == TEXT("Hash")) {
+        engine_->SearchParams.HashSize = FMath::Clamp(value, 1, 1024);
+    } else if(tokens[2] == TEXT("Threads")) {
+        engine_->SearchParams.HelperThreads = FMath::Clamp(value, 1, 64) - 1;
+    } else if(tokens[2] == TEXT("OwnBook")) {
+        engine_->SearchParams.UseOpeningBook = tokens[4] == TEXT("true");
+    } else if(tokens[2] == TEXT("BookFile")) {
+        // the path may contain spaces
+        FString path;
+        for(auto i = 4; i < tokens.Num(); ++i)
+            path += (path.IsEmpty() ? TEXT("") : TEXT(" ")) + tokens[i];
+        engine_->SearchParams.OpeningBook = path == TEXT("<empty>") ? FString() : path;
+    }
+}
+
+void FUciSession::Position(const TArray<FString>& tokens)
+{
+    // position [startpos | fen <fen>] [moves <move>..]
+    auto index = 1;
+    FString fen;
+    if(index < tokens.Num() && tokens[index] == TEXT("startpos")) {
+        fen = start_fen;
+        ++index;
+    } else if(index < tokens.Num() && tokens[index] == TEXT("fen")) {
+        for(++index; index < tokens.Num() && tokens[index] != TEXT("moves"); ++index)
+            fen += (fen.IsEmpty() ? TEXT("") : TEXT(" ")) + tokens[index];
+    } else {
+        return;
+    }
+
+    engine_->Set(fen);
+
+    if(index < tokens.Num() && tokens[index] == TEXT("moves")) {
+        for(++index; index < tokens.Num(); ++index) {
+            FMove move;
+            if(!engine_->ParseMove(tokens[index], move) || !engine_->MakeMove(move))
+                break;
+        }
+    }
+}
+
+void FUciSession::Go(const TArray<FString>& tokens)
+{
+    int32 depth = max_depth - 1;
+    int32 time_left[2] = {0, 0};
+    int32 increment[2] = {0, 0};
+    int32 moves_to_go = 0;
+    int32 move_time = 0;
+    auto infinite = false;
+    auto ponder = false;
+
+    for(auto i = 1; i < tokens.Num(); ++i) {
+        const auto& token = tokens[i];
+        const auto value = i + 1 < tokens.Num() ? FCString::Atoi(*tokens[i + 1]) : 0;
+
+        if(token == TEXT("infinite")) infinite = true;
+        else if(token == TEXT("ponder")) ponder = true;
+        else if(token == TEXT("depth")) depth = FMath::Clamp(value, 1, max_depth - 1);
+        else if(token == TEXT("movetime")) move_time = value;
+        else if(token == TEXT("wtime")) time_left[ESide::white] = value;
+        else if(token == TEXT("btime")) time_left[ESide::black] = value;
+        else if(token == TEXT("winc")) increment[ESide::white] = value;
+        else if(token == TEXT("binc")) increment[ESide::black] = value;
+        else if(token == TEXT("movestogo")) moves_to_go = value;
+    }
+
+    const auto side = engine_->GetSide();
+    float time_set = 0;
+    if(move_time > 0)
+        time_set = FMath::Max(move_time - MOVE_OVERHEAD, 10) / 1000.f;
+    else if(time_left[side] > 0)
+        time_set = AllocateTime(time_left[side], increment[side], moves_to_go);
+
+    // the clock only starts once the ponder move is actually played
+    ponder_hit_time_ = ponder ? time_set : 0;
+    engine_->SearchParams.Depth = depth;
+    engine_->SearchParams.TimeSet = ponder ? 0 : time_set;
+    is_waiting_for_stop_ = infinite || ponder;
+    // the last search is over, nothing else writes it until the next ponderhit
+    engine_->SearchInfo->PonderStopTimeMs.Reset();
+
+    is_searching_ = true;
+    auto* engine = engine_;
+    auto* waiting_for_stop = &is_waiting_for_stop_;
+    search_ = Async<void>(EAsyncExecution::Thread, [engine, waiting_for_stop]() -> void
+    {
+        const auto best_move = engine->FindBestMove();
+
+        // uci forbids answering an infinite or ponder search before being told to
+        while(*waiting_for_stop)
+            FPlatformProcess::Sleep(0.001f);
+
+        const auto pv = engine->GetPrincipalVariation(2);
+        if(pv.Num() > 1 && pv[0] == best_move)
+            Send(FString::Printf(TEXT("bestmove %s ponder %s"), *best_move.ToString(), *pv[1].ToString()));
+        else
+            Send(FString::Printf(TEXT("bestmove %s"), *best_move.ToString()));
+    });
+}
+
+void FUciSession::Stop()
+{
+    if(!is_searching_)
+        return;
+
+    // repeated in case the search has not yet cleared its flags when stop arrives
+    is_waiting_for_stop_ = false;
+    while(!search_.IsReady()) {
+        engine_->StopSearch();
+        FPlatformProcess::Sleep(0.001f);
+    }
+    WaitForSearch();
+}
+
+void FUciSession::PonderHit()
+{
+    if(!is_searching_)
+        return;
+
+    // keep searching, but now against the clock. not through StopTimeSet,
+    // the search may not have cleared its info yet
+    if(ponder_hit_time_ > 0)
+        engine_->SearchInfo->PonderStopTimeMs.Set(int64((FPlatformTime::Seconds() + ponder_hit_time_) * 1000));
+    is_waiting_for_stop_ = false;
+}
+
+void FUciSession::Perft(const TArray<FString>& tokens) const
+{
+    if(tokens.Num() > 1 && tokens[1] == TEXT("suite")) {
+        const auto max_depth = tokens.Num() > 2 ? FCString::Atoi(*tokens[2]) : 4;
+        Send(engine_->PerftSuite(max_depth).TrimEnd());
+    } else if(tokens.Num() > 1) {
+        Send(engine_->Divide(FMath::Max(1, FCString::Atoi(*tokens[1]))).TrimEnd());
+    }
+}
+
+void FUciSession::Bench(const TArray<FString>& tokens) const
+{
+    // the progress lines would only get in the way of the summary
+    engine_->IterationCompletedDelegate.Unbind();
+    if(tokens.Num() > 1 && tokens[1] == TEXT("copymake"))
+        Send(engine_->CompareCopyMake().TrimEnd());
+    else if(tokens.Num() > 1)
+        Send(engine_->Bench(FMath::Max(1, FCString::Atoi(*tokens[1]))).TrimEnd());
+    else
+        Send(engine_->Bench().TrimEnd());
+    engine_->IterationCompletedDelegate.BindRaw(this, &FUciSession::OnIterationCompleted);
+}
+
+void FUciSession::WaitForSearch()
+{
+    if(!is_searching_)
+        return;
+
+    search_.Wait();
+    is_searching_ = false;
+}
+
+void FUciSession::OnIterationCompleted(const int32 depth, const int32 score) const
+{
+    const auto* info = engine_->SearchInfo;
+    const auto elapsed = FPlatformTime::Seconds() - info->StartTime;
+    const auto nodes = info->AllThreadsVisitedNodes;
+
+    FString pv;
+    for(const auto& move : engine_->GetPrincipalVariation(depth))
+        pv += TEXT(" ") + move.ToString();
+
+    Send(FString::Printf(TEXT("info depth %d score %s nodes %lld nps %lld time %lld pv%s"),
+        depth, *ScoreToString(score), nodes,
+        static_cast<int64>(elapsed > 0 ? nodes / elapsed : 0),
+        static_cast<int64>(elapsed * 1000), *pv));
+}
+
+void FUciSession::Send(const FString& str)
+{
+    printf("%s\n", TCHAR_TO_UTF8(*str));
+    fflush(stdout);
+}
@@ -0,0 +1,48 @@
+// Copyright 2018 Emre Simsirli
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async.h"
+#include "ThreadSafeBool.h"
+
+class UChessEngine;
+
+// reads uci commands from stdin and answers on stdout until quit.
+// searches run on their own thread so that stop and ponderhit are
+// handled while the engine is thinking. besides uci it understands
+// "perft <depth>", "perft suite [max depth]" and "bench [depth]"
+class FUciSession
+{
+    UChessEngine* engine_;
+    TFuture<void> search_;
+    bool is_searching_;
+
+    // go infinite and go ponder must not answer before stop or ponderhit
+    FThreadSafeBool is_waiting_for_stop_;
+    // seconds to think once the ponder move is played, zero if unlimited
+    float ponder_hit_time_;
+
+public:
+    FUciSession();
+    ~FUciSession();
+
+    void Run();
+    // false once the session should end
+    bool HandleCommand(const FString& line);
+
+private:
+    void Uci() const;
+    void SetOption(const TArray<FString>& tokens);
+    void Position(const TArray<FString>& tokens);
+    void Go(const TArray<FString>& tokens);
+    void Stop();
+    void PonderHit();
+    void Perft(const TArray<FString>& tokens) const;
+    void Bench(const TArray<FString>& tokens) const;
+    void WaitForSearch();
+
+    void OnIterationCompleted(int32 depth, int32 score) const;
+
+    static void Send(const FString& str);
+};